@@ -0,0 +1,193 @@
+// 测量一种大整数实现在不同位数下各项运算的耗时、分配次数与内存峰值
+// 每次编译只测一个头文件（各头文件定义同名的类，不能同时包含），bench.sh 依次编译并汇总全部实现
+// 编译：g++ -std=c++17 -O2 -pthread -DBENCH_HEADER='"BigUInt.h"' -DBENCH_TYPE=big_uint -o bench Benchmark.cpp
+// 用法：./bench [--max 位数] [--time 秒] [--ops add,mul,...] [--format text|csv|json]
+#ifndef BENCH_HEADER
+#define BENCH_HEADER "BigUIntStd.h"
+#endif
+#ifndef BENCH_TYPE
+#define BENCH_TYPE big_uint
+#endif
+#include BENCH_HEADER
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+using T = BENCH_TYPE;
+
+#define BENCH_STR2(x) #x
+#define BENCH_STR(x) BENCH_STR2(x)
+
+std::mt19937 gen(20240601);
+
+// 定长版本有 MAX_SIZE，其余版本的位数不受限制
+template <class U, class = void> struct capacity {
+    static constexpr size_t value = size_t(-1);
+};
+template <class U> struct capacity<U, std::void_t<decltype(U::MAX_SIZE)>> {
+    static constexpr size_t value = U::MAX_SIZE;
+};
+// 是否提供返回 T 的 pow(T, long long)，排除 <cmath> 中的 pow
+template <class U, class = void> struct has_pow : std::false_type {};
+template <class U>
+struct has_pow<U, std::enable_if_t<std::is_same_v<decltype(pow(std::declval<U>(), 1LL)), U>>> : std::true_type {};
+
+// 阻止编译器把结果优化掉
+template <class U> void keep(const U &x) { asm volatile("" : : "g"(&x) : "memory"); }
+
+// 进程的内存峰值（KB）；Linux 上每次测量前通过 clear_refs 清零，得到的是这次测量的峰值
+void reset_peak() {
+#if defined(__linux__)
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+long peak_kb() {
+#if defined(__linux__)
+    std::ifstream in("/proc/self/status");
+    for (std::string line; std::getline(in, line);)
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return std::atol(line.c_str() + 6);
+    // 没有 /proc 时只能取整个进程的峰值
+    rusage r;
+    getrusage(RUSAGE_SELF, &r);
+    return r.ru_maxrss;
+#else
+    return 0;
+#endif
+}
+
+// n 个 10^4 进制位（4n 个十进制数字）的随机数，最高位为 head
+std::string digits(size_t n, char head) {
+    std::string s(n * 4, '0');
+    s[0] = head;
+    for (size_t i = 1; i < s.size(); i++)
+        s[i] = '0' + gen() % 10;
+    return s;
+}
+
+struct Result {
+    std::string op;
+    size_t limbs;
+    size_t reps;
+    double ns;     // 每次运算的纳秒数
+    double allocs; // 每次运算经 Memory::allocate 的申请次数
+    long peak;     // 内存峰值（KB）
+};
+
+// 先运行一次预热，再把次数加倍直到总耗时不少于 seconds
+Result measure(const std::string &op, size_t n, double seconds, const std::function<void()> &f) {
+    using clock = std::chrono::steady_clock;
+    reset_peak();
+    f();
+    size_t reps = 1;
+    for (;;) {
+        size_t before = Memory::stats().allocations;
+        auto start = clock::now();
+        for (size_t i = 0; i < reps; i++)
+            f();
+        double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        size_t allocations = Memory::stats().allocations - before;
+        if (elapsed >= seconds || reps >= (size_t(1) << 30))
+            return {op, n, reps, elapsed * 1e9 / reps, double(allocations) / reps, peak_kb()};
+        reps *= 2;
+    }
+}
+
+// 运算名、所需的位数上限（相对 n 的倍数）与运算本身
+struct Op {
+    const char *name;
+    size_t need;
+    std::function<void(const T &a, const T &b, const std::string &s, size_t n)> run;
+};
+// 写成模板，没有 pow 的版本中 if constexpr 才会丢弃那一段
+template <class U = T> std::vector<Op> operations() {
+    std::vector<Op> ops = {
+        {"construct", 1, [](const T &a, const T &, const std::string &, size_t) { T c(a); keep(c); }},
+        {"parse", 1, [](const T &, const T &, const std::string &s, size_t) { T c(s); keep(c); }},
+        {"print", 1, [](const T &a, const T &, const std::string &, size_t) { keep(a.to_string()); }},
+        {"add", 1, [](const T &a, const T &b, const std::string &, size_t) { T c = a + b; keep(c); }},
+        {"sub", 1, [](const T &a, const T &b, const std::string &, size_t) { T c = a - b; keep(c); }},
+        {"mul", 2, [](const T &a, const T &b, const std::string &, size_t) { T c = a * b; keep(c); }},
+        {"square", 2, [](const T &a, const T &, const std::string &, size_t) { T c = a * a; keep(c); }},
+    };
+    // 3^e 约有 n 个 10^4 进制位
+    if constexpr (has_pow<U>::value)
+        ops.push_back({"pow", 1, [](const T &, const T &, const std::string &, size_t n) {
+                           U c = pow(U(3), (long long)(n * 4 / 0.47712125472));
+                           keep(c);
+                       }});
+    return ops;
+}
+
+int main(int argc, char *argv[]) {
+    size_t max = 1000000;
+    double seconds = 0.2;
+    std::string only, format = "text";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--max")
+            max = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (key == "--time")
+            seconds = std::atof(argv[i + 1]);
+        else if (key == "--ops")
+            only = "," + std::string(argv[i + 1]) + ",";
+        else if (key == "--format")
+            format = argv[i + 1];
+    }
+    std::string variant = BENCH_HEADER;
+    variant.resize(variant.find('.'));
+
+    // 位数按 1, 10, 100, ... 递增；两个乘数都为 n 位
+    std::vector<Result> results;
+    if (format == "text")
+        std::printf("%-14s %-10s %10s %14s %14s %10s %10s\n", "variant", "op", "limbs", "ns/op", "limbs/s",
+                    "allocs/op", "peak_kb");
+    for (size_t n = 1; n <= max; n *= 10) {
+        if (n + 1 > capacity<T>::value)
+            break;
+        std::string sa = digits(n, '9'), sb = digits(n, '1');
+        T a(sa), b(sb);
+        for (const Op &op : operations()) {
+            if (!only.empty() && only.find("," + std::string(op.name) + ",") == std::string::npos)
+                continue;
+            if (n * op.need > capacity<T>::value)
+                continue;
+            Result r = measure(op.name, n, seconds, [&] { op.run(a, b, sa, n); });
+            if (format == "text")
+                std::printf("%-14s %-10s %10zu %14.1f %14.4g %10.2f %10ld\n", variant.c_str(), r.op.c_str(),
+                            r.limbs, r.ns, r.limbs / r.ns * 1e9, r.allocs, r.peak);
+            std::fflush(stdout);
+            results.push_back(r);
+        }
+    }
+
+    if (format == "csv") {
+        std::printf("variant,type,op,limbs,reps,ns_per_op,limbs_per_s,allocs_per_op,peak_rss_kb\n");
+        for (auto &r : results)
+            std::printf("%s,%s,%s,%zu,%zu,%.1f,%.6g,%.2f,%ld\n", variant.c_str(), BENCH_STR(BENCH_TYPE),
+                        r.op.c_str(), r.limbs, r.reps, r.ns, r.limbs / r.ns * 1e9, r.allocs, r.peak);
+    } else if (format == "json") {
+        std::printf("{\"variant\": \"%s\", \"type\": \"%s\", \"results\": [", variant.c_str(), BENCH_STR(BENCH_TYPE));
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result &r = results[i];
+            std::printf("%s\n  {\"op\": \"%s\", \"limbs\": %zu, \"reps\": %zu, \"ns_per_op\": %.1f, "
+                        "\"limbs_per_s\": %.6g, \"allocs_per_op\": %.2f, \"peak_rss_kb\": %ld}",
+                        i ? "," : "", r.op.c_str(), r.limbs, r.reps, r.ns, r.limbs / r.ns * 1e9, r.allocs, r.peak);
+        }
+        std::printf("\n]}\n");
+    }
+    return 0;
+}
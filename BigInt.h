@@ -1,28 +1,46 @@
+#include "Multiply.h"
+#include "Divide.h"
+#include "Decimal.h"
+#include "Scalar.h"
+#include "Memory.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <random>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+// 对象内直接存放的位数，位数更多时才分配堆空间
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 4
+#endif
+
 const size_t pow10[19] = {1, 10, 100, 1000, 10000};
 const size_t MAX_SIZE = 1024;
 const size_t BIT_SIZE = 4;
 const size_t BIT_LIMIT = pow10[BIT_SIZE];
-const int P = 998244353;
 
 class big_int {
   public:
     using value_type = int;
+    static constexpr size_t INLINE_LIMBS = BIGINT_INLINE_LIMBS;
+    static_assert(INLINE_LIMBS > 0, "BIGINT_INLINE_LIMBS 至少为 1");
 
     // 构造函数
     big_int();
     big_int(const big_int &t);
     big_int(big_int &&t);
     big_int(value_type num);
-    big_int(const std::string &num);
+    big_int(std::string_view num);
+    // std::string 需单独重载才能写 big_int b = s；写成模板，字面量不会匹配它
+    template <class Alloc> big_int(const std::basic_string<char, std::char_traits<char>, Alloc> &num);
+    big_int(const char *num, size_t n);
 
     // 析构函数
     ~big_int();
@@ -31,10 +49,15 @@ class big_int {
     big_int &operator=(const big_int &t);
     big_int &operator=(big_int &&t);
     big_int &operator=(value_type num);
-    big_int &operator=(const std::string &num);
+    big_int &operator=(std::string_view num);
+    template <class Alloc>
+    big_int &operator=(const std::basic_string<char, std::char_traits<char>, Alloc> &num);
 
     // 输入输出
     friend std::ostream &operator<<(std::ostream &os, const big_int &t);
+    std::string to_string() const;
+    std::to_chars_result to_chars(char *first, char *last) const;
+    friend std::from_chars_result from_chars(const char *first, const char *last, big_int &value);
 
     // 算术运算
     friend big_int operator+(const big_int &a, const big_int &b);
@@ -43,6 +66,44 @@ class big_int {
     big_int &operator-=(const big_int &t);
     friend big_int operator*(const big_int &a, const big_int &b);
     big_int &operator*=(const big_int &t);
+    friend big_int operator/(const big_int &a, const big_int &b);
+    big_int &operator/=(const big_int &t);
+    friend big_int operator%(const big_int &a, const big_int &b);
+    big_int &operator%=(const big_int &t);
+    friend std::pair<big_int, big_int> divmod(const big_int &a, const big_int &b);
+    // 与单个机器字的运算
+    friend big_int operator+(const big_int &a, int64_t x);
+    friend big_int operator+(int64_t x, const big_int &a);
+    big_int &operator+=(int64_t x);
+    friend big_int operator-(const big_int &a, int64_t x);
+    big_int &operator-=(int64_t x);
+    friend big_int operator*(const big_int &a, int64_t x);
+    friend big_int operator*(int64_t x, const big_int &a);
+    big_int &operator*=(int64_t x);
+    friend big_int operator/(const big_int &a, int64_t x);
+    big_int &operator/=(int64_t x);
+    friend int64_t operator%(const big_int &a, int64_t x);
+    big_int &operator%=(int64_t x);
+    // 右值版本，结果写在临时对象的空间上
+    friend big_int operator+(big_int &&a, const big_int &b);
+    friend big_int operator+(const big_int &a, big_int &&b);
+    friend big_int operator+(big_int &&a, big_int &&b);
+    friend big_int operator-(big_int &&a, const big_int &b);
+    friend big_int operator-(const big_int &a, big_int &&b);
+    friend big_int operator-(big_int &&a, big_int &&b);
+    friend big_int operator*(big_int &&a, const big_int &b);
+    friend big_int operator*(const big_int &a, big_int &&b);
+    friend big_int operator*(big_int &&a, big_int &&b);
+    friend big_int operator+(big_int &&a, int64_t x);
+    friend big_int operator+(int64_t x, big_int &&a);
+    friend big_int operator-(big_int &&a, int64_t x);
+    friend big_int operator*(big_int &&a, int64_t x);
+    friend big_int operator*(int64_t x, big_int &&a);
+    big_int &square();
+    // dst = a * b，dst 可以与 a 或 b 相同；乘法的临时空间从 ws 中取用，不指定时用本线程的工作区
+    friend void mul(big_int &dst, const big_int &a, const big_int &b, Memory::Workspace &ws);
+    friend void mul(big_int &dst, const big_int &a, const big_int &b);
+    void shrink_to_fit();
 
     // 比较运算
     friend bool operator==(const big_int &a, const big_int &b);
@@ -52,202 +113,316 @@ class big_int {
 
   private:
     // 内部辅助函数
-    void copyByString(const std::string &num);
+    void copyByString(std::string_view num);
     static int sgn(value_type x);
     static int compareAbs(const big_int &a, const big_int &b);
     static void plus(value_type a[], value_type b[], size_t al, size_t bl);
     static void minus(value_type a[], value_type b[], size_t al, size_t bl);
-    static void multiply(value_type a[], value_type b[], size_t al, size_t bl, bool ntt);
-    static void NTT(value_type a[], size_t n, int inv);
-    static int ksm(int a, int b, int P);
-    static int inv(int a, int P);
+    static void minusFrom(value_type a[], value_type b[], size_t bl);
+    big_int &plusAbs(const big_int &t, int sign);
+    big_int &plusAbs(uint64_t x, int sign);
 
     void resize(size_t new_capacity);
+    void release();
+    void assign(const value_type p[], size_t n);
+    void append(uint64_t c);
 
     // 成员变量
     size_t len = 0;
     value_type signum = 0;
-    size_t capacity = 4; // 默认容量为4
-    value_type *data = nullptr;
+    size_t capacity = INLINE_LIMBS;
+    value_type *data = local;
+    value_type local[INLINE_LIMBS] = {}; // 不超过 INLINE_LIMBS 位时直接存放在对象内，不分配内存
 };
 // 构造函数
-big_int::big_int() : data(new value_type[capacity]{0}) {}
-big_int::big_int(const big_int &t)
-    : signum(t.signum), len(t.len), capacity(t.capacity), data(new value_type[capacity]{0}) {
-    std::copy(t.data, t.data + t.len, data);
-}
-big_int::big_int(big_int &&t) : signum(t.signum), len(t.len), capacity(t.capacity), data(t.data) {
-    t.signum = 0;
-    t.len = 0;
-    t.capacity = 0;
-    t.data = nullptr;
-}
-big_int::big_int(value_type num) : signum(sgn(num)), data(new value_type[capacity]{0}) {
-    num *= signum;
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
-        if (len == capacity) {
-            resize(capacity * 2);
-        }
-    }
+big_int::big_int() {}
+
+big_int::big_int(const big_int &t) : signum(t.signum) {
+    assign(t.data, t.len);
 }
-big_int::big_int(const std::string &num) : data(new value_type[capacity]{0}) { copyByString(num); }
+
+big_int::big_int(big_int &&t) { *this = std::move(t); }
+
+big_int::big_int(value_type num) : signum(sgn(num)) { append(num < 0 ? 0 - uint64_t(num) : num); }
+
+big_int::big_int(std::string_view num) { copyByString(num); }
+big_int::big_int(const char *num, size_t n) : big_int(std::string_view(num, n)) {}
+template <class Alloc>
+big_int::big_int(const std::basic_string<char, std::char_traits<char>, Alloc> &num)
+    : big_int(std::string_view(num)) {}
+
 // 析构函数
-big_int::~big_int() { delete[] data; }
+big_int::~big_int() {
+    if (data != local)
+        Memory::deallocate(data, capacity);
+}
 
+// 容量不足 new_capacity 时换到堆上更大的空间，新空间只清零 len 之后的部分，离开 local 时把它清零
 void big_int::resize(size_t new_capacity) {
     if (new_capacity <= capacity)
         return;
-    value_type *new_data = new value_type[new_capacity]{0};
-    std::copy(data, data + len, new_data);
-    delete[] data;
+    value_type *new_data = Memory::allocate<value_type>(new_capacity);
+    std::fill(std::copy(data, data + len, new_data), new_data + new_capacity, 0);
+    if (data == local)
+        std::fill(local, local + INLINE_LIMBS, 0);
+    else
+        Memory::deallocate(data, capacity);
     data = new_data;
     capacity = new_capacity;
 }
-// 赋值运算符
+// 释放堆上的空间，回到值为 0 的内联状态
+void big_int::release() {
+    if (data != local)
+        Memory::deallocate(data, capacity);
+    std::fill(local, local + INLINE_LIMBS, 0);
+    data = local;
+    capacity = INLINE_LIMBS;
+    len = 0;
+    signum = 0;
+}
+// 把值设为 p[0, n)，需要换空间时直接申请恰好 n 位且不清零
+void big_int::assign(const value_type p[], size_t n) {
+    if (n > capacity) {
+        value_type *new_data = Memory::allocate<value_type>(n);
+        if (data == local)
+            std::fill(local, local + INLINE_LIMBS, 0);
+        else
+            Memory::deallocate(data, capacity);
+        data = new_data;
+        capacity = n;
+    } else if (n < len)
+        std::fill(data + n, data + len, 0);
+    std::copy(p, p + n, data);
+    len = n;
+}
+// 把 c 按进制拆开接在最高位之后
+void big_int::append(uint64_t c) {
+    for (; c; c /= BIT_LIMIT) {
+        if (len == capacity)
+            resize(capacity * 2);
+        data[len++] = c % BIT_LIMIT;
+    }
+}
+// 赋值运算符，空间足够时不重新分配
 big_int &big_int::operator=(const big_int &t) {
     if (this == &t)
         return *this;
-    delete[] data;
+    assign(t.data, t.len);
     signum = t.signum;
-    len = t.len;
-    capacity = t.capacity;
-    data = new value_type[capacity]{0};
-    std::copy(t.data, t.data + t.len, data);
     return *this;
 }
+
+// t 在堆上时直接接管它的空间，否则只复制 local 中的几位
 big_int &big_int::operator=(big_int &&t) {
     if (this == &t)
         return *this;
-    delete[] data;
-    signum = t.signum;
-    len = t.len;
-    capacity = t.capacity;
-    data = t.data;
-    t.signum = 0;
-    t.len = 0;
-    t.capacity = 0;
-    t.data = nullptr;
+    if (t.data == t.local) {
+        std::fill(data, data + len, 0);
+        std::copy(t.local, t.local + t.len, data);
+        len = t.len;
+        signum = t.signum;
+        t.release();
+    } else {
+        release();
+        len = t.len;
+        signum = t.signum;
+        capacity = t.capacity;
+        data = t.data;
+        t.len = 0;
+        t.signum = 0;
+        t.capacity = INLINE_LIMBS;
+        t.data = t.local;
+    }
     return *this;
 }
+
 big_int &big_int::operator=(value_type num) {
-    delete[] data;
-    signum = sgn(num);
-    num *= signum;
-    data = new value_type[capacity]{0};
+    std::fill(data, data + len, 0);
     len = 0;
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
-        if (len == capacity) {
-            resize(capacity * 2);
-        }
-    }
+    signum = sgn(num);
+    append(num < 0 ? 0 - uint64_t(num) : num);
     return *this;
 }
-big_int &big_int::operator=(const std::string &num) {
-    delete[] data;
-    capacity = 4;
-    data = new value_type[capacity]{0};
+
+big_int &big_int::operator=(std::string_view num) {
     copyByString(num);
     return *this;
 }
+template <class Alloc>
+big_int &big_int::operator=(const std::basic_string<char, std::char_traits<char>, Alloc> &num) {
+    return *this = std::string_view(num);
+}
 // 输出
+std::string big_int::to_string() const {
+    std::string s((signum == -1) + Decimal::length(data, len), '-');
+    Decimal::to_chars(&s[signum == -1], &s[0] + s.size(), data, len);
+    return s;
+}
+std::to_chars_result big_int::to_chars(char *first, char *last) const {
+    if (signum == -1) {
+        if (first == last)
+            return {last, std::errc::value_too_large};
+        *first++ = '-';
+    }
+    return Decimal::to_chars(first, last, data, len);
+}
 std::ostream &operator<<(std::ostream &os, const big_int &t) {
-    if (t.signum == -1)
-        os << '-';
-    if (t.len == 0)
-        return os << 0;
-    for (int i = t.len - 1; i >= 0; i--)
-        os << t.data[i];
-    return os;
+    std::string s = t.to_string();
+    return os.write(s.data(), s.size());
 }
 // 算术运算
-big_int operator+(const big_int &a, const big_int &b) {
+// 复合赋值都在原有的空间上进行，只有位数增长超过容量时才重新分配
+big_int operator+(const big_int &a, const big_int &b) { return big_int(a) + b; }
+big_int &big_int::operator+=(const big_int &t) { return plusAbs(t, t.signum); }
+big_int operator-(const big_int &a, const big_int &b) { return big_int(a) - b; }
+big_int &big_int::operator-=(const big_int &t) { return plusAbs(t, -t.signum); }
+// 乘积直接写入新对象，不复制 a
+big_int operator*(const big_int &a, const big_int &b) {
     big_int c;
-    if (a.signum == b.signum) {
-        c = a;
-        c.len = std::max(c.len, b.len);
-        c.resize(c.len + 1);
-        big_int::plus(c.data, b.data, c.len, b.len);
-        c.len++;
-    } else {
-        int cmp = big_int::compareAbs(a, b);
-        if (cmp == 1) {
-            c = a;
-            c.resize(c.len);
-            big_int::minus(c.data, b.data, c.len, b.len);
-        } else if (cmp == -1) {
-            c = b;
-            c.resize(c.len);
-            big_int::minus(c.data, a.data, c.len, a.len);
-        }
-    }
-    while (c.len && !c.data[c.len - 1])
-        c.len--;
+    mul(c, a, b);
     return c;
 }
-big_int &big_int::operator+=(const big_int &t) {
-    big_int c;
-    c = *this + t;
-    *this = std::move(c);
+big_int &big_int::operator*=(const big_int &t) {
+    mul(*this, *this, t);
     return *this;
 }
-big_int operator-(const big_int &a, const big_int &b) {
-    big_int c;
-    if (a.signum != b.signum) {
-        c = a;
-        c.len = std::max(a.len, b.len);
-        c.resize(c.len + 1);
-        big_int::plus(c.data, b.data, c.len, b.len);
-        c.len++;
-    } else {
-        int cmp = big_int::compareAbs(a, b);
-        if (cmp == 1) {
-            c = a;
-            c.signum = 1;
-            c.resize(c.len);
-            big_int::minus(c.data, b.data, c.len, b.len);
-        } else if (cmp == -1) {
-            c = b;
-            c.signum = -1;
-            c.resize(c.len);
-            big_int::minus(c.data, a.data, c.len, a.len);
-        }
-    }
-    while (c.len && !c.data[c.len - 1])
-        c.len--;
-    return c;
+// 右值版本，结果写在临时对象的空间上，两边都是临时对象时用容量大的一个
+big_int operator+(big_int &&a, const big_int &b) { return std::move(a += b); }
+big_int operator+(const big_int &a, big_int &&b) { return std::move(b += a); }
+big_int operator+(big_int &&a, big_int &&b) {
+    return a.capacity >= b.capacity ? std::move(a += b) : std::move(b += a);
 }
-big_int &big_int::operator-=(const big_int &t) {
-    big_int c;
-    c = *this - t;
-    *this = std::move(c);
+big_int operator-(big_int &&a, const big_int &b) { return std::move(a -= b); }
+// a - b = -(b - a)
+big_int operator-(const big_int &a, big_int &&b) {
+    b -= a;
+    b.signum = -b.signum;
+    return std::move(b);
+}
+big_int operator-(big_int &&a, big_int &&b) { return std::move(a -= b); }
+big_int operator*(big_int &&a, const big_int &b) { return std::move(a *= b); }
+big_int operator*(const big_int &a, big_int &&b) { return std::move(b *= a); }
+big_int operator*(big_int &&a, big_int &&b) {
+    return a.capacity >= b.capacity ? std::move(a *= b) : std::move(b *= a);
+}
+big_int operator+(big_int &&a, int64_t x) { return std::move(a += x); }
+big_int operator+(int64_t x, big_int &&a) { return std::move(a += x); }
+big_int operator-(big_int &&a, int64_t x) { return std::move(a -= x); }
+big_int operator*(big_int &&a, int64_t x) { return std::move(a *= x); }
+big_int operator*(int64_t x, big_int &&a) { return std::move(a *= x); }
+// 除法，返回商和余数，除数不能为 0
+// 与内置整数相同，商向零截断，余数与被除数同号：a == q * b + r 且 |r| < |b|
+std::pair<big_int, big_int> divmod(const big_int &a, const big_int &b) {
+    assert(b.signum != 0);
+    if (big_int::compareAbs(a, b) < 0)
+        return {big_int(), a};
+    big_int q, r;
+    q.resize(a.len - b.len + 1);
+    r.resize(b.len);
+    ::Divide::divide<big_int::value_type, BIT_LIMIT>(a.data, a.len, b.data, b.len, q.data, r.data);
+    q.len = a.len - b.len + 1;
+    r.len = b.len;
+    while (q.len && !q.data[q.len - 1])
+        q.len--;
+    while (r.len && !r.data[r.len - 1])
+        r.len--;
+    q.signum = q.len ? a.signum * b.signum : 0;
+    r.signum = r.len ? a.signum : 0;
+    return {std::move(q), std::move(r)};
+}
+big_int operator/(const big_int &a, const big_int &b) { return divmod(a, b).first; }
+big_int &big_int::operator/=(const big_int &t) { return *this = divmod(*this, t).first; }
+big_int operator%(const big_int &a, const big_int &b) { return divmod(a, b).second; }
+big_int &big_int::operator%=(const big_int &t) { return *this = divmod(*this, t).second; }
+// 与单个机器字的运算，一趟完成，除了最高位的进位外不分配内存
+// 除法与内置整数相同，商向零截断，余数与被除数同号
+big_int operator+(const big_int &a, int64_t x) { return big_int(a) + x; }
+big_int operator+(int64_t x, const big_int &a) { return big_int(a) + x; }
+big_int &big_int::operator+=(int64_t x) { return plusAbs(x < 0 ? 0 - uint64_t(x) : x, (x > 0) - (x < 0)); }
+big_int operator-(const big_int &a, int64_t x) { return big_int(a) - x; }
+big_int &big_int::operator-=(int64_t x) { return plusAbs(x < 0 ? 0 - uint64_t(x) : x, (x < 0) - (x > 0)); }
+big_int operator*(const big_int &a, int64_t x) { return big_int(a) * x; }
+big_int operator*(int64_t x, const big_int &a) { return big_int(a) * x; }
+big_int &big_int::operator*=(int64_t x) {
+    signum *= (x > 0) - (x < 0);
+    append(::Scalar::mul_1<value_type, BIT_LIMIT>(data, len, x < 0 ? 0 - uint64_t(x) : x));
+    while (len && !data[len - 1])
+        len--;
     return *this;
 }
-big_int operator*(const big_int &a, const big_int &b) {
-    big_int c;
-    if (a.signum * b.signum != 0) {
-        c = a;
-        c.signum = a.signum * b.signum;
-        c.len = a.len + b.len;
-        c.resize(c.len * 4);
-        big_int::multiply(c.data, b.data, c.len, b.len, a.len + b.len > 128);
-    }
-    while (c.len && !c.data[c.len - 1])
-        c.len--;
-    return c;
+big_int operator/(const big_int &a, int64_t x) { return std::move(big_int(a) /= x); }
+big_int &big_int::operator/=(int64_t x) {
+    assert(x != 0);
+    ::Scalar::div_1<value_type, BIT_LIMIT>(data, len, x < 0 ? 0 - uint64_t(x) : x);
+    while (len && !data[len - 1])
+        len--;
+    signum = len ? signum * ((x > 0) - (x < 0)) : 0;
+    return *this;
 }
-big_int &big_int::operator*=(const big_int &t) {
-    big_int c;
-    c = *this * t;
-    *this = std::move(c);
+int64_t operator%(const big_int &a, int64_t x) {
+    assert(x != 0);
+    int64_t r = ::Scalar::mod_1<big_int::value_type, BIT_LIMIT>(a.data, a.len, x < 0 ? 0 - uint64_t(x) : x);
+    return a.signum < 0 ? -r : r;
+}
+big_int &big_int::operator%=(int64_t x) {
+    assert(x != 0);
+    uint64_t r = ::Scalar::mod_1<value_type, BIT_LIMIT>(data, len, x < 0 ? 0 - uint64_t(x) : x);
+    std::fill(data, data + len, 0);
+    len = 0;
+    append(r);
+    signum = len ? signum : 0;
     return *this;
 }
+big_int &big_int::square() {
+    mul(*this, *this, *this);
+    return *this;
+}
+void mul(big_int &dst, const big_int &a, const big_int &b, Memory::Workspace &ws) {
+    int signum = a.signum * b.signum;
+    if (!signum) {
+        std::fill(dst.data, dst.data + dst.len, 0);
+        dst.len = dst.signum = 0;
+        return;
+    }
+    size_t n = a.len + b.len;
+    // 结果直接写入 dst，dst 不是乘数时不必保留原来的值
+    if (&dst != &a && &dst != &b) {
+        std::fill(dst.data, dst.data + dst.len, 0);
+        dst.len = 0;
+    }
+    // 多留一位给随后加法的进位
+    dst.resize(n + 1);
+    ::Multiply::multiply(a.data, a.len, b.data, b.len, dst.data, ws);
+    dst.len = n;
+    dst.signum = signum;
+    while (dst.len && !dst.data[dst.len - 1])
+        dst.len--;
+}
+void mul(big_int &dst, const big_int &a, const big_int &b) { mul(dst, a, b, Memory::workspace()); }
+// 容量缩到恰好 len 位，不超过 INLINE_LIMBS 位时回到对象内
+void big_int::shrink_to_fit() {
+    if (data == local || capacity == len)
+        return;
+    value_type *old = data;
+    size_t old_capacity = capacity;
+    if (len <= INLINE_LIMBS)
+        data = local, capacity = INLINE_LIMBS;
+    else
+        data = Memory::allocate<value_type>(len), capacity = len;
+    std::copy(old, old + len, data);
+    Memory::deallocate(old, old_capacity);
+}
+// 先把 a 平方到 b 的最低一位 1，结果从 a 的副本开始，b 为 2 的幂时直接把 a 移出去
 big_int pow(big_int a, long long b) {
-    big_int res(1);
-    for (; b; a *= a, b >>= 1) {
+    if (b == 0)
+        return big_int(1);
+    for (; !(b & 1); b >>= 1)
+        a.square();
+    if (b == 1)
+        return a;
+    big_int res = a;
+    while (b >>= 1) {
+        a.square();
         if (b & 1)
             res *= a;
     }
@@ -271,19 +446,23 @@ bool operator<=(const big_int &a, const big_int &b) {
         return big_int::compareAbs(a, b) * a.signum <= 0;
 }
 // 辅助函数
-void big_int::copyByString(const std::string &num) {
-    if (num.front() == '0' && num.size() == 1) {
-        signum = len = 0;
-    } else {
-        signum = num[0] == '-' ? -1 : 1;
-        size_t n = num.size() - (signum == -1);
-        len = (n - 1) / BIT_SIZE + 1;
-        resize(len);
-        for (size_t i = 0, j = num.size() - 1; i < n; i++, j--) {
-            assert(num[j] >= '0' && num[j] <= '9');
-            data[i / BIT_SIZE] += (num[j] - '0') * pow10[i % BIT_SIZE];
-        }
-    }
+void big_int::copyByString(std::string_view num) {
+    auto [ptr, ec] = from_chars(num.data(), num.data() + num.size(), *this);
+    assert(ec == std::errc() && ptr == num.data() + num.size());
+}
+std::from_chars_result from_chars(const char *first, const char *last, big_int &value) {
+    bool negative = first != last && *first == '-';
+    size_t n = Decimal::digits(first + negative, last);
+    if (n == 0)
+        return {first, std::errc::invalid_argument};
+    size_t old = value.len, l = (n + 3) / 4;
+    value.len = 0;
+    value.resize(l);
+    value.len = Decimal::parse(first + negative, n, value.data);
+    // 原来更长时把多出的部分清零
+    std::fill(value.data + l, value.data + std::max(l, old), 0);
+    value.signum = value.len ? (negative ? -1 : 1) : 0;
+    return {first + negative + n, std::errc()};
 }
 int big_int::sgn(value_type x) { return (x > 0) - (x < 0); }
 int big_int::compareAbs(const big_int &a, const big_int &b) {
@@ -297,6 +476,7 @@ int big_int::compareAbs(const big_int &a, const big_int &b) {
     }
 }
 void big_int::plus(value_type a[], value_type b[], size_t al, size_t bl) {
+    BIG_STATS_SCOPE(big_stats::add, al);
     for (int i = 0; i < al; i++) {
         if (i < bl)
             a[i] += b[i];
@@ -307,6 +487,7 @@ void big_int::plus(value_type a[], value_type b[], size_t al, size_t bl) {
     }
 }
 void big_int::minus(value_type a[], value_type b[], size_t al, size_t bl) {
+    BIG_STATS_SCOPE(big_stats::sub, al);
     for (int i = 0; i < al; i++) {
         if (i < bl)
             a[i] -= b[i];
@@ -316,63 +497,64 @@ void big_int::minus(value_type a[], value_type b[], size_t al, size_t bl) {
         }
     }
 }
-void big_int::multiply(value_type a[], value_type b[], size_t al, size_t bl, bool ntt) {
-    if (ntt) {
-        size_t len = 2 << std::__lg(al + bl - 1);
-        value_type *t = new value_type[len];
-        std::copy(b, b + bl, t);
-        NTT(a, len, 1);
-        NTT(t, len, 1);
-        for (int i = 0; i < len; i++)
-            a[i] = 1LL * a[i] * b[i] % P;
-        NTT(a, len, -1);
-        delete[] t;
-    } else {
-        if (al == 0 || bl == 0) {
-            std::fill(a, a + al, 0);
-            return;
-        }
-        for (int k = al + bl - 2; k >= 0; k--) {
-            value_type tmp = 0;
-            for (int i = std::min(k, (int)al - 1); i >= 0 && k - i < bl; i--)
-                tmp += a[i] * b[k - i];
-            a[k] = tmp;
-        }
-    }
-    for (int i = 0; i < al + bl; i++) {
-        a[i + 1] += a[i] / BIT_LIMIT;
-        a[i] %= BIT_LIMIT;
+// a[0, bl) = b[0, bl) - a[0, bl)，要求 b >= a
+void big_int::minusFrom(value_type a[], value_type b[], size_t bl) {
+    BIG_STATS_SCOPE(big_stats::sub, bl);
+    value_type borrow = 0;
+    for (size_t i = 0; i < bl; i++) {
+        a[i] = b[i] - a[i] - borrow;
+        borrow = a[i] < 0;
+        if (borrow)
+            a[i] += BIT_LIMIT;
     }
 }
-int big_int::ksm(int a, int b, int P) {
-    int s = 1;
-    for (; b; b >>= 1, a = 1LL * a * a % P)
-        if (b & 1)
-            s = 1LL * s * a % P;
-    return s;
-}
-int big_int::inv(int a, int P) { return big_int::ksm(a, P - 2, P); }
-void big_int::NTT(value_type a[], size_t n, int inv) {
-    std::vector<size_t> rev(n);
-    for (size_t i = 0; i < n; i++) {
-        rev[i] = (rev[i >> 1] >> 1) | ((i & 1) << std::__lg(n >> 1));
-        if (i < rev[i])
-            std::swap(a[i], a[rev[i]]);
+// *this += sign * |t|，sign 为 0 时不变；t 可以是 *this 本身
+big_int &big_int::plusAbs(const big_int &t, int sign) {
+    if (!sign)
+        return *this;
+    if (this == &t) {
+        // 自己加自己是乘 2，自己减自己是 0
+        return sign == signum ? *this *= 2 : *this *= 0;
     }
-    for (size_t i = 2; i <= n; i <<= 1) {
-        int gn = ksm(inv == 1 ? 3 : big_int::inv(3, P), (P - 1) / i, P);
-        for (size_t j = 0; j < n; j += i) {
-            int g0 = 1;
-            for (size_t k = j; k < j + i / 2; ++k, g0 = 1LL * g0 * gn % P) {
-                int x = a[k], y = 1LL * g0 * a[k + i / 2] % P;
-                a[k] = (x + y) % P;
-                a[k + i / 2] = (x - y + P) % P;
-            }
-        }
+    if (signum != -sign) {
+        signum = sign;
+        resize(std::max(len, t.len) + 1);
+        len = std::max(len, t.len);
+        plus(data, t.data, len, t.len);
+        len++;
+    } else if (compareAbs(*this, t) >= 0) {
+        minus(data, t.data, len, t.len);
+    } else {
+        // 绝对值小于 t，原地算 |t| - |*this|，符号随 t
+        resize(t.len);
+        minusFrom(data, t.data, t.len);
+        len = t.len;
+        signum = sign;
     }
-    if (inv == -1) {
-        int n_inv = big_int::inv(n, P);
-        for (int i = 0; i < n; i++)
-            a[i] = 1LL * a[i] * n_inv % P;
+    while (len && !data[len - 1])
+        len--;
+    signum = len ? signum : 0;
+    return *this;
+}
+// *this += sign * x，x 为绝对值
+big_int &big_int::plusAbs(uint64_t x, int sign) {
+    if (!x)
+        return *this;
+    if (signum != -sign) {
+        signum = sign;
+        append(::Scalar::add_1<value_type, BIT_LIMIT>(data, len, x));
+    } else if (::Scalar::cmp_1<value_type, BIT_LIMIT>(data, len, x) >= 0) {
+        ::Scalar::sub_1<value_type, BIT_LIMIT>(data, len, x);
+        while (len && !data[len - 1])
+            len--;
+        signum = len ? signum : 0;
+    } else {
+        // 绝对值小于 x，结果就是 x - |*this|
+        uint64_t v = ::Scalar::value<value_type, BIT_LIMIT>(data, len);
+        std::fill(data, data + len, 0);
+        len = 0;
+        append(x - v);
+        signum = sign;
     }
+    return *this;
 }
@@ -1,332 +1,402 @@
+#include "Multiply.h"
+#include "Decimal.h"
+
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <random>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
-class big_int {
+
+// big_int 的位数上限（10^4 进制），即 fixed_big_int<BIGINT_STATIC_LIMBS>
+#ifndef BIGINT_STATIC_LIMBS
+#define BIGINT_STATIC_LIMBS 1024
+#endif
+// Limbs 不超过此值时运行时的乘法只用栈上的草稿区（约 80 * Limbs 字节），不用 NTT，也不分配内存；
+// 更大时草稿区放不进栈，改用 Multiply::multiply，其中的工作区与 NTT 会分配堆空间
+#ifndef BIGINT_STATIC_STACK_LIMBS
+#define BIGINT_STATIC_STACK_LIMBS 2048
+#endif
+
+// C++20 起构造、赋值、加减乘与比较都是 constexpr，可以在编译期求值
+#ifndef BIGINT_STATIC_CONSTEXPR
+#if __cplusplus >= 202002L
+#define BIGINT_STATIC_CONSTEXPR constexpr
+#define BIGINT_STATIC_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+#define BIGINT_STATIC_CONSTEXPR
+#define BIGINT_STATIC_CONSTANT_EVALUATED() false
+#endif
+#endif
+
+// 定长有符号大整数：绝对值至多 Limbs 个 10^4 进制位，存放在对象内的 std::array 中，不分配堆空间
+// 只有 data[0, len) 有意义，复制时只复制这一段；结果超过 Limbs 位时 assert 失败
+// 乘法的草稿区在栈上，Limbs 超过 BIGINT_STATIC_STACK_LIMBS 时例外
+// 编译期求值时整个 data 都会初始化，乘法改用朴素乘法，字符串逐个字符解析
+template <size_t Limbs> class fixed_big_int {
   public:
     using value_type = int;
+    static constexpr size_t MAX_SIZE = Limbs;
+    static constexpr size_t BIT_SIZE = 4;
+    static constexpr value_type BIT_LIMIT = 10000;
+    static_assert(Limbs > 0, "Limbs 至少为 1");
 
     // 构造函数
-    big_int();
-    big_int(const big_int &t);
-    big_int(big_int &&t);
-    big_int(long long num);
-    big_int(const std::string &num);
-
-    // 析构函数
-    ~big_int();
+    BIGINT_STATIC_CONSTEXPR fixed_big_int();
+    BIGINT_STATIC_CONSTEXPR fixed_big_int(const fixed_big_int &t);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int(long long num);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int(std::string_view num);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int(const char *num, size_t n);
 
     // 赋值操作符
-    big_int &operator=(const big_int &t);
-    big_int &operator=(big_int &&t);
-    big_int &operator=(long long num);
-    big_int &operator=(const std::string &num);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int &operator=(const fixed_big_int &t);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int &operator=(long long num);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int &operator=(std::string_view num);
 
     // 输入输出
-    friend std::ostream &operator<<(std::ostream &os, const big_int &t);
+    template <size_t N> friend std::ostream &operator<<(std::ostream &os, const fixed_big_int<N> &t);
+    std::string to_string() const;
+    std::to_chars_result to_chars(char *first, char *last) const;
+    template <size_t N>
+    friend std::from_chars_result from_chars(const char *first, const char *last, fixed_big_int<N> &value);
 
     // 算术运算
-    friend big_int operator+(const big_int &a, const big_int &b);
-    big_int &operator+=(const big_int &t);
-    friend big_int operator-(const big_int &a, const big_int &b);
-    big_int &operator-=(const big_int &t);
-    friend big_int operator*(const big_int &a, const big_int &b);
-    big_int &operator*=(const big_int &t);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int operator-() const;
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR fixed_big_int<N> operator+(const fixed_big_int<N> &a,
+                                                             const fixed_big_int<N> &b);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int &operator+=(const fixed_big_int &t);
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR fixed_big_int<N> operator-(const fixed_big_int<N> &a,
+                                                             const fixed_big_int<N> &b);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int &operator-=(const fixed_big_int &t);
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR fixed_big_int<N> operator*(const fixed_big_int<N> &a,
+                                                             const fixed_big_int<N> &b);
+    BIGINT_STATIC_CONSTEXPR fixed_big_int &operator*=(const fixed_big_int &t);
 
     // 比较运算
-    friend bool operator==(const big_int &a, const big_int &b);
-    friend bool operator!=(const big_int &a, const big_int &b);
-    friend bool operator<(const big_int &a, const big_int &b);
-    friend bool operator<=(const big_int &a, const big_int &b);
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR bool operator==(const fixed_big_int<N> &a, const fixed_big_int<N> &b);
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR bool operator<(const fixed_big_int<N> &a, const fixed_big_int<N> &b);
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR bool operator<=(const fixed_big_int<N> &a, const fixed_big_int<N> &b);
 
   private:
-    static const size_t MAX_SIZE, BIT_SIZE, BIT_LIMIT, pow10[19];
-    static const int P;
-
     // 内部辅助函数
-    void copyByString(const std::string &num);
-    static int sgn(long long x);
-    static int compareAbs(const big_int &a, const big_int &b);
-    static void plus(value_type a[], value_type b[], value_type c[], size_t l);
-    static void minus(value_type a[], value_type b[], value_type c[], size_t l);
-    static void multiply(value_type a[], value_type b[], value_type c[], size_t al, size_t bl,
-                         bool ntt);
-    static void NTT(value_type a[], size_t n, int inv);
-    static int ksm(int a, int b);
+    BIGINT_STATIC_CONSTEXPR void copyByString(std::string_view num);
+    static BIGINT_STATIC_CONSTEXPR int compareAbs(const fixed_big_int &a, const fixed_big_int &b);
+    static BIGINT_STATIC_CONSTEXPR size_t plus(const value_type a[], size_t al, const value_type b[], size_t bl,
+                                               value_type c[]);
+    static BIGINT_STATIC_CONSTEXPR size_t minus(const value_type a[], size_t al, const value_type b[], size_t bl,
+                                                value_type c[]);
+    static BIGINT_STATIC_CONSTEXPR fixed_big_int plusAbs(const fixed_big_int &a, const fixed_big_int &b, int sign);
+    static BIGINT_STATIC_CONSTEXPR void multiplyBasecase(const value_type a[], size_t al, const value_type b[],
+                                                         size_t bl, value_type c[]);
+    static void multiplyRuntime(const value_type a[], size_t al, const value_type b[], size_t bl,
+                                value_type c[]);
 
     // 成员变量
     size_t len = 0;
     value_type signum = 0;
-    value_type *data = nullptr;
+    std::array<value_type, Limbs> data;
 };
+using big_int = fixed_big_int<BIGINT_STATIC_LIMBS>;
+
 // 构造函数
-big_int::big_int() : data(new value_type[MAX_SIZE]{0}) {}
-big_int::big_int(const big_int &t)
-    : signum(t.signum), len(t.len), data(new value_type[MAX_SIZE]{0}) {
-    std::copy(t.data, t.data + t.len, data);
+template <size_t Limbs> BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs>::fixed_big_int() {
+    if (BIGINT_STATIC_CONSTANT_EVALUATED())
+        data.fill(0);
 }
-big_int::big_int(big_int &&t) : signum(t.signum), len(t.len), data(t.data) {
-    t.signum = 0;
-    t.len = 0;
-    t.data = nullptr;
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs>::fixed_big_int(const fixed_big_int &t) : fixed_big_int() {
+    *this = t;
 }
-big_int::big_int(long long num) : signum(sgn(num)), data(new value_type[MAX_SIZE]{0}) {
-    num *= signum;
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
-    }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs>::fixed_big_int(long long num) : fixed_big_int() {
+    *this = num;
+}
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs>::fixed_big_int(std::string_view num) : fixed_big_int() {
+    copyByString(num);
 }
-big_int::big_int(const std::string &num) : data(new value_type[MAX_SIZE]{0}) { copyByString(num); }
-// 析构函数
-big_int::~big_int() { delete[] data; }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs>::fixed_big_int(const char *num, size_t n)
+    : fixed_big_int(std::string_view(num, n)) {}
 // 赋值运算符
-big_int &big_int::operator=(const big_int &t) {
-    if (this == &t)
-        return *this;
-    delete[] data;
-    signum = t.signum;
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> &fixed_big_int<Limbs>::operator=(const fixed_big_int &t) {
     len = t.len;
-    data = new value_type[MAX_SIZE]{0};
-    std::copy(t.data, t.data + t.len, data);
-    return *this;
-}
-big_int &big_int::operator=(big_int &&t) {
-    if (this == &t)
-        return *this;
-    delete[] data;
     signum = t.signum;
-    len = t.len;
-    data = t.data;
-    t.signum = 0;
-    t.len = 0;
-    t.data = nullptr;
+    std::copy(t.data.begin(), t.data.begin() + t.len, data.begin());
     return *this;
 }
-big_int &big_int::operator=(long long num) {
-    delete[] data;
-    signum = sgn(num);
-    num *= signum;
-    data = new value_type[MAX_SIZE]{0};
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> &fixed_big_int<Limbs>::operator=(long long num) {
+    signum = (num > 0) - (num < 0);
     len = 0;
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
+    for (uint64_t x = num < 0 ? 0 - uint64_t(num) : num; x; x /= BIT_LIMIT) {
+        assert(len < Limbs);
+        data[len++] = x % BIT_LIMIT;
     }
     return *this;
 }
-big_int &big_int::operator=(const std::string &num) {
-    delete[] data;
-    data = new value_type[MAX_SIZE]{0};
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> &fixed_big_int<Limbs>::operator=(std::string_view num) {
     copyByString(num);
     return *this;
 }
 // 输出
-std::ostream &operator<<(std::ostream &os, const big_int &t) {
-    if (t.signum == -1)
-        os << '-';
-    for (int i = t.len - 1; i >= 0; i--)
-        os << t.data[i];
-    return os;
+template <size_t Limbs> std::string fixed_big_int<Limbs>::to_string() const {
+    std::string s((signum == -1) + Decimal::length(data.data(), len), '-');
+    Decimal::to_chars(&s[signum == -1], &s[0] + s.size(), data.data(), len);
+    return s;
 }
-// 算术运算
-big_int operator+(const big_int &a, const big_int &b) {
-    big_int c;
-    if (a.signum == b.signum) {
-        c.signum = a.signum;
-        c.len = std::max(a.len, b.len) + 1;
-        big_int::plus(a.data, b.data, c.data, c.len);
-    } else {
-        int cmp = big_int::compareAbs(a, b);
-        if (cmp == 1) {
-            c.signum = a.signum;
-            c.len = a.len;
-            big_int::minus(a.data, b.data, c.data, c.len);
-        } else if (cmp == -1) {
-            c.signum = b.signum;
-            c.len = b.len;
-            big_int::minus(b.data, a.data, c.data, c.len);
-        }
+template <size_t Limbs> std::to_chars_result fixed_big_int<Limbs>::to_chars(char *first, char *last) const {
+    if (signum == -1) {
+        if (first == last)
+            return {last, std::errc::value_too_large};
+        *first++ = '-';
     }
-    while (c.len && !c.data[c.len - 1])
-        c.len--;
-    return c;
+    return Decimal::to_chars(first, last, data.data(), len);
 }
-big_int &big_int::operator+=(const big_int &t) {
-    big_int c;
-    c = *this + t;
-    *this = std::move(c);
-    return *this;
+template <size_t Limbs> std::ostream &operator<<(std::ostream &os, const fixed_big_int<Limbs> &t) {
+    std::string s = t.to_string();
+    return os.write(s.data(), s.size());
 }
-big_int operator-(const big_int &a, const big_int &b) {
-    big_int c;
-    if (a.signum != b.signum) {
+// 算术运算
+// a + sign * b，按绝对值的大小决定相加还是相减
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> fixed_big_int<Limbs>::plusAbs(const fixed_big_int &a,
+                                                                           const fixed_big_int &b, int sign) {
+    if (!b.signum)
+        return a;
+    fixed_big_int c;
+    if (a.signum == b.signum * sign) {
         c.signum = a.signum;
-        c.len = std::max(a.len, b.len) + 1;
-        big_int::plus(a.data, b.data, c.data, c.len);
+        c.len = plus(a.data.data(), a.len, b.data.data(), b.len, c.data.data());
     } else {
-        int cmp = big_int::compareAbs(a, b);
+        int cmp = compareAbs(a, b);
         if (cmp == 1) {
             c.signum = a.signum;
-            c.len = a.len;
-            big_int::minus(a.data, b.data, c.data, c.len);
+            c.len = minus(a.data.data(), a.len, b.data.data(), b.len, c.data.data());
         } else if (cmp == -1) {
-            c.signum = -1 * b.signum;
-            c.len = b.len;
-            big_int::minus(b.data, a.data, c.data, c.len);
+            c.signum = b.signum * sign;
+            c.len = minus(b.data.data(), b.len, a.data.data(), a.len, c.data.data());
         }
     }
-    while (c.len && !c.data[c.len - 1])
-        c.len--;
     return c;
 }
-big_int &big_int::operator-=(const big_int &t) {
-    big_int c;
-    c = *this - t;
-    *this = std::move(c);
-    return *this;
+template <size_t Limbs> BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> fixed_big_int<Limbs>::operator-() const {
+    fixed_big_int c(*this);
+    c.signum = -c.signum;
+    return c;
 }
-big_int operator*(const big_int &a, const big_int &b) {
-    big_int c;
-    if (a.signum * b.signum != 0) {
-        c.signum = a.signum * b.signum;
-        c.len = a.len + b.len;
-        if (a.len + b.len > 128) {
-            big_int::multiply(a.data, b.data, c.data, a.len, b.len, true);
-        } else {
-            big_int::multiply(a.data, b.data, c.data, a.len, b.len, false);
-        }
-    }
-    while (c.len && !c.data[c.len - 1])
-        c.len--;
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> operator+(const fixed_big_int<Limbs> &a,
+                                                       const fixed_big_int<Limbs> &b) {
+    return fixed_big_int<Limbs>::plusAbs(a, b, 1);
+}
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> &fixed_big_int<Limbs>::operator+=(const fixed_big_int &t) {
+    return *this = *this + t;
+}
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> operator-(const fixed_big_int<Limbs> &a,
+                                                       const fixed_big_int<Limbs> &b) {
+    return fixed_big_int<Limbs>::plusAbs(a, b, -1);
+}
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> &fixed_big_int<Limbs>::operator-=(const fixed_big_int &t) {
+    return *this = *this - t;
+}
+// 乘积直接写入 c，两个乘数都不被修改；去掉最高位的 0 后超过 Limbs 位时 assert 失败
+// 乘积至少有 a.len + b.len - 1 位，a.len + b.len 恰好为 Limbs + 1 时先写入 spill，看最高位是否为 0
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> operator*(const fixed_big_int<Limbs> &a,
+                                                       const fixed_big_int<Limbs> &b) {
+    using value_type = typename fixed_big_int<Limbs>::value_type;
+    fixed_big_int<Limbs> c;
+    if (a.signum * b.signum == 0)
+        return c;
+    size_t n = a.len + b.len;
+    assert(n - 1 <= Limbs);
+    std::array<value_type, Limbs + 1> spill;
+    value_type *p = n <= Limbs ? c.data.data() : spill.data();
+    if (BIGINT_STATIC_CONSTANT_EVALUATED())
+        fixed_big_int<Limbs>::multiplyBasecase(a.data.data(), a.len, b.data.data(), b.len, p);
+    else
+        fixed_big_int<Limbs>::multiplyRuntime(a.data.data(), a.len, b.data.data(), b.len, p);
+    while (n && !p[n - 1])
+        n--;
+    assert(n <= Limbs);
+    if (p != c.data.data())
+        std::copy(p, p + n, c.data.begin());
+    c.len = n;
+    c.signum = a.signum * b.signum;
     return c;
 }
-big_int &big_int::operator*=(const big_int &t) {
-    big_int c;
-    c = *this * t;
-    *this = std::move(c);
-    return *this;
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_int<Limbs> &fixed_big_int<Limbs>::operator*=(const fixed_big_int &t) {
+    return *this = *this * t;
 }
 // 比较运算
-bool operator==(const big_int &a, const big_int &b) {
-    return (a.signum == b.signum) && !big_int::compareAbs(a, b);
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR bool operator==(const fixed_big_int<Limbs> &a, const fixed_big_int<Limbs> &b) {
+    return (a.signum == b.signum) && !fixed_big_int<Limbs>::compareAbs(a, b);
 }
-bool operator!=(const big_int &a, const big_int &b) { return !(a == b); }
-bool operator<(const big_int &a, const big_int &b) {
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR bool operator!=(const fixed_big_int<Limbs> &a, const fixed_big_int<Limbs> &b) {
+    return !(a == b);
+}
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR bool operator<(const fixed_big_int<Limbs> &a, const fixed_big_int<Limbs> &b) {
     if (a.signum != b.signum)
         return a.signum < b.signum;
     else
-        return big_int::compareAbs(a, b) * a.signum < 0;
+        return fixed_big_int<Limbs>::compareAbs(a, b) * a.signum < 0;
 }
-bool operator<=(const big_int &a, const big_int &b) {
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR bool operator<=(const fixed_big_int<Limbs> &a, const fixed_big_int<Limbs> &b) {
     if (a.signum != b.signum)
         return a.signum < b.signum;
     else
-        return big_int::compareAbs(a, b) * a.signum <= 0;
+        return fixed_big_int<Limbs>::compareAbs(a, b) * a.signum <= 0;
+}
+// 字面量：123456789012345678901234567890_big，负数写作 -x_big
+// 只接受不带前导零的十进制数字，带 ' 分隔符、十六进制或八进制形式的字面量在编译时报错
+// C++20 起值保存在 big_int_literal 中，在编译期解析并放进只读数据段，运行时不再解析；
+// C++17 下变量模板的动态初始化之间没有确定的顺序，因此每次按值返回，在运行时解析
+template <char... C> constexpr bool big_int_literal_digits = ((C >= '0' && C <= '9') && ...);
+// 以 0 开头的整数字面量在 C++ 中是八进制，为避免误读，除 0_big 外不允许前导零
+template <char C0, char... C> constexpr bool big_int_literal_leading_zero = C0 == '0' && sizeof...(C) > 0;
+#if __cplusplus >= 202002L
+template <char... C>
+constexpr big_int big_int_literal =
+    big_int(std::string_view(std::array<char, sizeof...(C)>{C...}.data(), sizeof...(C)));
+template <char... C> constexpr const big_int &operator""_big() {
+    static_assert(big_int_literal_digits<C...>, "_big 字面量只能由十进制数字组成");
+    static_assert(!big_int_literal_leading_zero<C...>, "_big 字面量不能有前导零");
+    return big_int_literal<C...>;
 }
+#else
+template <char... C> big_int operator""_big() {
+    static_assert(big_int_literal_digits<C...>, "_big 字面量只能由十进制数字组成");
+    static_assert(!big_int_literal_leading_zero<C...>, "_big 字面量不能有前导零");
+    return big_int(std::string_view(std::array<char, sizeof...(C)>{C...}.data(), sizeof...(C)));
+}
+#endif
 // 辅助函数
-void big_int::copyByString(const std::string &num) {
-    if (num.front() == '0' && num.size() == 1) {
-        signum = len = 0;
-    } else {
-        signum = num[0] == '-' ? -1 : 1;
-        size_t n = num.size() - (signum == -1);
-        len = (n - 1) / BIT_SIZE + 1;
-        for (size_t i = 0, j = num.size() - 1; i < n; i++, j--)
-            data[i / BIT_SIZE] += (num[j] - '0') * pow10[i % BIT_SIZE];
+// 编译期逐个字符解析，运行时交给 from_chars
+template <size_t Limbs> BIGINT_STATIC_CONSTEXPR void fixed_big_int<Limbs>::copyByString(std::string_view num) {
+    if (BIGINT_STATIC_CONSTANT_EVALUATED()) {
+        bool negative = !num.empty() && num[0] == '-';
+        num.remove_prefix(negative);
+        for (char c : num)
+            assert(c >= '0' && c <= '9');
+        // 前导零不占位数
+        while (num.size() > 1 && num[0] == '0')
+            num.remove_prefix(1);
+        assert(!num.empty() && (num.size() + 3) / 4 <= Limbs);
+        len = Decimal::parse_constexpr(num.data(), num.size(), data.data());
+        signum = len ? (negative ? -1 : 1) : 0;
+        return;
     }
+    auto [ptr, ec] = from_chars(num.data(), num.data() + num.size(), *this);
+    assert(ec == std::errc() && ptr == num.data() + num.size());
 }
-int big_int::sgn(long long x) { 
-    int res =  (x > 0) - (x < 0); 
-    return res;
+template <size_t Limbs>
+std::from_chars_result from_chars(const char *first, const char *last, fixed_big_int<Limbs> &value) {
+    bool negative = first != last && *first == '-';
+    const char *p = first + negative;
+    size_t n = Decimal::digits(p, last), z = 0;
+    if (n == 0)
+        return {first, std::errc::invalid_argument};
+    // 跳过前导零后仍超过 Limbs 位时与 std::from_chars 相同：返回 result_out_of_range，value 不变
+    while (z + 1 < n && p[z] == '0')
+        z++;
+    if ((n - z + 3) / 4 > Limbs)
+        return {p + n, std::errc::result_out_of_range};
+    value.len = Decimal::parse(p + z, n - z, value.data.data());
+    value.signum = value.len ? (negative ? -1 : 1) : 0;
+    return {p + n, std::errc()};
 }
-int big_int::compareAbs(const big_int &a, const big_int &b) {
-    if (a.len == b.len) {
-        for (int i = a.len - 1; i >= 0; i--)
-            if (a.data[i] != b.data[i])
-                return sgn(a.data[i] - b.data[i]);
-        return 0;
-    } else {
-        return sgn(a.len - b.len);
-    }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR int fixed_big_int<Limbs>::compareAbs(const fixed_big_int &a, const fixed_big_int &b) {
+    if (a.len != b.len)
+        return a.len < b.len ? -1 : 1;
+    for (size_t i = a.len; i-- > 0;)
+        if (a.data[i] != b.data[i])
+            return a.data[i] < b.data[i] ? -1 : 1;
+    return 0;
 }
-void big_int::plus(value_type a[], value_type b[], value_type c[], size_t l) {
-    for (int i = 0; i < l; i++) {
-        c[i] += a[i] + b[i];
-        if (c[i] >= BIT_LIMIT) {
-            c[i + 1]++;
+// c = a + b，返回 c 的位数
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR size_t fixed_big_int<Limbs>::plus(const value_type a[], size_t al, const value_type b[],
+                                                          size_t bl, value_type c[]) {
+    size_t n = std::max(al, bl);
+    value_type carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        c[i] = (i < al ? a[i] : 0) + (i < bl ? b[i] : 0) + carry;
+        carry = c[i] >= BIT_LIMIT;
+        if (carry)
             c[i] -= BIT_LIMIT;
-        }
     }
-}
-void big_int::minus(value_type a[], value_type b[], value_type c[], size_t l) {
-    for (int i = 0; i < l; i++) {
-        c[i] += a[i] - b[i];
-        if (c[i] < 0) {
-            c[i + 1]--;
-            c[i] += BIT_LIMIT;
-        }
+    if (carry) {
+        assert(n < Limbs);
+        c[n++] = 1;
     }
+    return n;
 }
-void big_int::multiply(value_type a[], value_type b[], value_type c[], size_t al, size_t bl,
-                       bool ntt) {
-    if (ntt) {
-        size_t n = al + bl, len = 2 << std::__lg(n - 1);
-        NTT(a, len, 1);
-        NTT(b, len, 1);
-        for (int i = 0; i < len; i++)
-            c[i] = 1LL * a[i] * b[i] % P;
-        NTT(c, len, -1);
-        NTT(a, len, -1);
-        NTT(b, len, -1);
-    } else {
-        for (int i = 0; i < al; i++)
-            for (int j = 0; j < bl; j++)
-                c[i + j] += a[i] * b[j];
-    }
-    for (int i = 0; i < al + bl; i++) {
-        c[i + 1] += c[i] / BIT_LIMIT;
-        c[i] %= BIT_LIMIT;
+// c = a - b，要求 a > b，返回 c 去掉前导零后的位数
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR size_t fixed_big_int<Limbs>::minus(const value_type a[], size_t al, const value_type b[],
+                                                           size_t bl, value_type c[]) {
+    value_type borrow = 0;
+    for (size_t i = 0; i < al; i++) {
+        c[i] = a[i] - (i < bl ? b[i] : 0) - borrow;
+        borrow = c[i] < 0;
+        if (borrow)
+            c[i] += BIT_LIMIT;
     }
+    while (al && !c[al - 1])
+        al--;
+    return al;
 }
-int big_int::ksm(int a, int b) {
-    int s = 1;
-    for (; b; b >>= 1, a = 1LL * a * a % P)
-        if (b & 1)
-            s = 1LL * s * a % P;
-    return s;
-}
-void big_int::NTT(value_type a[], size_t n, int inv) {
-    std::vector<size_t> rev(n);
-    for (size_t i = 0; i < n; i++) {
-        rev[i] = (rev[i >> 1] >> 1) | ((i & 1) << std::__lg(n >> 1));
-        if (i < rev[i])
-            std::swap(a[i], a[rev[i]]);
-    }
-    for (size_t i = 2; i <= n; i <<= 1) {
-        int gn = ksm(inv == 1 ? 3 : ksm(3, P - 2), (P - 1) / i);
-        for (size_t j = 0; j < n; j += i) {
-            int g0 = 1;
-            for (size_t k = j; k < j + i / 2; ++k, g0 = 1LL * g0 * gn % P) {
-                int x = a[k], y = 1LL * g0 * a[k + i / 2] % P;
-                a[k] = (x + y) % P;
-                a[k + i / 2] = (x - y + P) % P;
-            }
+// 编译期用的朴素乘法，c[0, al + bl) = a * b，c 可以是 a 或 b
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR void fixed_big_int<Limbs>::multiplyBasecase(const value_type a[], size_t al,
+                                                                    const value_type b[], size_t bl,
+                                                                    value_type c[]) {
+    std::array<value_type, Limbs + 1> t{};
+    for (size_t i = 0; i < al; i++) {
+        long long carry = 0;
+        for (size_t j = 0; j < bl; j++) {
+            long long x = t[i + j] + (long long)a[i] * b[j] + carry;
+            t[i + j] = x % BIT_LIMIT;
+            carry = x / BIT_LIMIT;
         }
+        if (bl)
+            t[i + bl] = carry;
     }
-    if (inv == -1) {
-        int n_inv = ksm(n, P - 2);
-        for (int i = 0; i < n; i++)
-            a[i] = 1LL * a[i] * n_inv % P;
+    std::copy(t.begin(), t.begin() + al + bl, c);
+}
+// 运行时的乘法，c[0, al + bl) = a * b，c 可以是 a 或 b；al + bl 不超过 Limbs + 1
+template <size_t Limbs>
+void fixed_big_int<Limbs>::multiplyRuntime(const value_type a[], size_t al, const value_type b[], size_t bl,
+                                           value_type c[]) {
+    if constexpr (Limbs <= BIGINT_STATIC_STACK_LIMBS) {
+        std::array<long long, ::Multiply::multiply_scratch_size(Limbs + 1, 0)> buffer;
+        ::Multiply::Scratch s{buffer.data(), buffer.data() + buffer.size()};
+        ::Multiply::multiply(a, al, b, bl, c, s);
+    } else {
+        ::Multiply::multiply(a, al, b, bl, c);
     }
 }
-
-const size_t big_int::pow10[19] = {1, 10, 100, 1000, 10000};
-const size_t big_int::MAX_SIZE = 1024;
-const size_t big_int::BIT_SIZE = 4;
-const size_t big_int::BIT_LIMIT = big_int::pow10[BIT_SIZE]; // MAX_SIZE * BIT_SIZE <= 2^64
-const int big_int::P = 998244353;
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "BigIntStatic.h"
+#include "test.h"
+
+#include <iostream>
+
+int main() {
+    test<big_int>();
+    edgetest<big_int>();
+    statictest<big_int>();
+    // 负数的加减乘与比较
+    for (long long a : {-491, -30, -7, 0, 7, 30, 491})
+        for (long long b : {-13, -7, -1, 0, 1, 7, 13})
+            check<big_int>(a, b);
+    // 取反与负的字面量
+    big_int x(12345);
+    if (-x != big_int(-12345) || -(-x) != x || -big_int(0) != big_int(0) || -123_big != big_int(-123))
+        std::cout << "ERROR unary minus" << std::endl;
+    // 带符号的 from_chars：超出位数时 value 不变，前导零不占位数
+    std::string over = "-1" + std::string(BIGINT_STATIC_LIMBS * 4, '0');
+    std::string full = "-" + std::string(10, '0') + std::string(BIGINT_STATIC_LIMBS * 4, '9');
+    auto [p1, e1] = from_chars(over.data(), over.data() + over.size(), x);
+    if (e1 != std::errc::result_out_of_range || p1 != over.data() + over.size() || x != big_int(12345))
+        std::cout << "ERROR signed from_chars out of range" << std::endl;
+    auto [p2, e2] = from_chars(full.data(), full.data() + full.size(), x);
+    if (e2 != std::errc() || x.to_string() != "-" + std::string(BIGINT_STATIC_LIMBS * 4, '9'))
+        std::cout << "ERROR signed from_chars leading zeros" << std::endl;
+    if (x * big_int(-1) != -x || (x * big_int(-1)).to_string() != std::string(BIGINT_STATIC_LIMBS * 4, '9'))
+        std::cout << "ERROR signed full width product" << std::endl;
+    return 0;
+}
@@ -6,6 +6,11 @@
 
 int main() {
     test<big_int>();
+    edgetest<big_int>();
+    // 负数：商向零截断，余数与被除数同号
+    for (long long a : {-491, -30, -7, 0, 7, 30, 491})
+        for (long long b : {-13, -7, -1, 1, 7, 13})
+            check<big_int>(a, b);
     randtest<big_int>;
     return 0;
 }
\ No newline at end of file
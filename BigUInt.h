@@ -1,29 +1,45 @@
-#include "NTT.hpp"
+#include "Multiply.h"
+#include "Divide.h"
+#include "Decimal.h"
+#include "Scalar.h"
+#include "Memory.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <random>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+// 对象内直接存放的位数，位数更多时才分配堆空间
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 4
+#endif
+
 const size_t pow10[19] = {1, 10, 100, 1000, 10000};
 const size_t BIT_SIZE = 4;
 const size_t BIT_LIMIT = pow10[BIT_SIZE];
-const int P = 998244353;
 
 class big_uint {
   public:
     using value_type = int;
+    static constexpr size_t INLINE_LIMBS = BIGINT_INLINE_LIMBS;
+    static_assert(INLINE_LIMBS > 0, "BIGINT_INLINE_LIMBS 至少为 1");
 
     // 构造函数
     big_uint();
     big_uint(const big_uint &t);
     big_uint(big_uint &&t);
     big_uint(value_type num);
-    big_uint(const std::string &num);
+    big_uint(std::string_view num);
+    // std::string 需单独重载才能写 big_uint b = s；写成模板，字面量不会匹配它
+    template <class Alloc> big_uint(const std::basic_string<char, std::char_traits<char>, Alloc> &num);
+    big_uint(const char *num, size_t n);
 
     // 析构函数
     ~big_uint();
@@ -32,10 +48,15 @@ class big_uint {
     big_uint &operator=(const big_uint &t);
     big_uint &operator=(big_uint &&t);
     big_uint &operator=(value_type num);
-    big_uint &operator=(const std::string &num);
+    big_uint &operator=(std::string_view num);
+    template <class Alloc>
+    big_uint &operator=(const std::basic_string<char, std::char_traits<char>, Alloc> &num);
 
     // 输入输出
     friend std::ostream &operator<<(std::ostream &os, const big_uint &t);
+    std::string to_string() const;
+    std::to_chars_result to_chars(char *first, char *last) const;
+    friend std::from_chars_result from_chars(const char *first, const char *last, big_uint &value);
 
     // 算术运算
     big_uint &operator+=(const big_uint &t);
@@ -44,6 +65,44 @@ class big_uint {
     friend big_uint operator-(const big_uint &a, const big_uint &b);
     big_uint &operator*=(const big_uint &t);
     friend big_uint operator*(const big_uint &a, const big_uint &b);
+    big_uint &operator/=(const big_uint &t);
+    friend big_uint operator/(const big_uint &a, const big_uint &b);
+    big_uint &operator%=(const big_uint &t);
+    friend big_uint operator%(const big_uint &a, const big_uint &b);
+    friend std::pair<big_uint, big_uint> divmod(const big_uint &a, const big_uint &b);
+    // 右值版本，结果写在临时对象的空间上
+    friend big_uint operator+(big_uint &&a, const big_uint &b);
+    friend big_uint operator+(const big_uint &a, big_uint &&b);
+    friend big_uint operator+(big_uint &&a, big_uint &&b);
+    friend big_uint operator-(big_uint &&a, const big_uint &b);
+    friend big_uint operator-(const big_uint &a, big_uint &&b);
+    friend big_uint operator-(big_uint &&a, big_uint &&b);
+    friend big_uint operator*(big_uint &&a, const big_uint &b);
+    friend big_uint operator*(const big_uint &a, big_uint &&b);
+    friend big_uint operator*(big_uint &&a, big_uint &&b);
+    friend big_uint operator+(big_uint &&a, int64_t x);
+    friend big_uint operator+(int64_t x, big_uint &&a);
+    friend big_uint operator-(big_uint &&a, int64_t x);
+    friend big_uint operator*(big_uint &&a, int64_t x);
+    friend big_uint operator*(int64_t x, big_uint &&a);
+    // 与单个机器字的运算，x 不能为负
+    big_uint &operator+=(int64_t x);
+    friend big_uint operator+(const big_uint &a, int64_t x);
+    friend big_uint operator+(int64_t x, const big_uint &a);
+    big_uint &operator-=(int64_t x);
+    friend big_uint operator-(const big_uint &a, int64_t x);
+    big_uint &operator*=(int64_t x);
+    friend big_uint operator*(const big_uint &a, int64_t x);
+    friend big_uint operator*(int64_t x, const big_uint &a);
+    big_uint &operator/=(int64_t x);
+    friend big_uint operator/(const big_uint &a, int64_t x);
+    big_uint &operator%=(int64_t x);
+    friend int64_t operator%(const big_uint &a, int64_t x);
+    big_uint &square();
+    // dst = a * b，dst 可以与 a 或 b 相同；乘法的临时空间从 ws 中取用，不指定时用本线程的工作区
+    friend void mul(big_uint &dst, const big_uint &a, const big_uint &b, Memory::Workspace &ws);
+    friend void mul(big_uint &dst, const big_uint &a, const big_uint &b);
+    void shrink_to_fit();
     std::string estimation(size_t sz);
 
     // 比较运算
@@ -54,120 +113,155 @@ class big_uint {
 
   private:
     // 内部辅助函数
-    void copyByString(const std::string &num);
+    void copyByString(std::string_view num);
     static int sgn(value_type x);
     static int compareAbs(const big_uint &a, const big_uint &b);
     static void plus(value_type a[], value_type b[], size_t al, size_t bl);
     static void minus(value_type a[], value_type b[], size_t al, size_t bl);
-    static void multiply(value_type a[], value_type b[], size_t al, size_t bl, bool ntt);
+    static void minusFrom(value_type a[], value_type b[], size_t bl);
 
     void resize(size_t new_capacity);
+    void release();
+    void assign(const value_type p[], size_t n);
+    void append(uint64_t c);
 
     // 成员变量
     size_t len = 0;
-    size_t capacity = 4; // 默认容量为4
-    value_type *data = nullptr;
+    size_t capacity = INLINE_LIMBS;
+    value_type *data = local;
+    value_type local[INLINE_LIMBS] = {}; // 不超过 INLINE_LIMBS 位时直接存放在对象内，不分配内存
 };
 // 构造函数
-big_uint::big_uint() : data(new value_type[capacity]{0}) {}
+big_uint::big_uint() {}
 
-big_uint::big_uint(const big_uint &t)
-    : len(t.len), capacity(t.capacity), data(new value_type[t.capacity]{0}) {
-    std::copy(t.data, t.data + t.len, data);
+big_uint::big_uint(const big_uint &t) {
+    assign(t.data, t.len);
 }
 
-big_uint::big_uint(big_uint &&t) : len(t.len), capacity(t.capacity), data(t.data) {
-    t.len = 0;
-    t.capacity = 0;
-    t.data = nullptr;
-}
+big_uint::big_uint(big_uint &&t) { *this = std::move(t); }
 
-big_uint::big_uint(value_type num) : data(new value_type[capacity]{0}) {
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
-        if (len == capacity) {
-            resize(capacity * 2);
-        }
-    }
-}
+big_uint::big_uint(value_type num) { append(num); }
 
-big_uint::big_uint(const std::string &num) : data(new value_type[capacity]{0}) {
-    copyByString(num);
-}
+big_uint::big_uint(std::string_view num) { copyByString(num); }
+big_uint::big_uint(const char *num, size_t n) : big_uint(std::string_view(num, n)) {}
+template <class Alloc>
+big_uint::big_uint(const std::basic_string<char, std::char_traits<char>, Alloc> &num)
+    : big_uint(std::string_view(num)) {}
 
 // 析构函数
-big_uint::~big_uint() { delete[] data; }
+big_uint::~big_uint() {
+    if (data != local)
+        Memory::deallocate(data, capacity);
+}
 
+// 容量不足 new_capacity 时换到堆上更大的空间，新空间只清零 len 之后的部分，离开 local 时把它清零
 void big_uint::resize(size_t new_capacity) {
     if (new_capacity <= capacity)
         return;
-    value_type *new_data = new value_type[new_capacity]{0};
-    std::copy(data, data + len, new_data);
-    delete[] data;
+    value_type *new_data = Memory::allocate<value_type>(new_capacity);
+    std::fill(std::copy(data, data + len, new_data), new_data + new_capacity, 0);
+    if (data == local)
+        std::fill(local, local + INLINE_LIMBS, 0);
+    else
+        Memory::deallocate(data, capacity);
     data = new_data;
     capacity = new_capacity;
 }
-// 赋值运算符
+// 释放堆上的空间，回到值为 0 的内联状态
+void big_uint::release() {
+    if (data != local)
+        Memory::deallocate(data, capacity);
+    std::fill(local, local + INLINE_LIMBS, 0);
+    data = local;
+    capacity = INLINE_LIMBS;
+    len = 0;
+}
+// 把值设为 p[0, n)，需要换空间时直接申请恰好 n 位且不清零
+void big_uint::assign(const value_type p[], size_t n) {
+    if (n > capacity) {
+        value_type *new_data = Memory::allocate<value_type>(n);
+        if (data == local)
+            std::fill(local, local + INLINE_LIMBS, 0);
+        else
+            Memory::deallocate(data, capacity);
+        data = new_data;
+        capacity = n;
+    } else if (n < len)
+        std::fill(data + n, data + len, 0);
+    std::copy(p, p + n, data);
+    len = n;
+}
+// 把 c 按进制拆开接在最高位之后
+void big_uint::append(uint64_t c) {
+    for (; c; c /= BIT_LIMIT) {
+        if (len == capacity)
+            resize(capacity * 2);
+        data[len++] = value_type(c % BIT_LIMIT);
+    }
+}
+// 赋值运算符，空间足够时不重新分配
 big_uint &big_uint::operator=(const big_uint &t) {
     if (this == &t)
         return *this;
-    delete[] data;
-    len = t.len;
-    capacity = t.capacity;
-    data = new value_type[capacity]{0};
-    std::copy(t.data, t.data + t.len, data);
+    assign(t.data, t.len);
     return *this;
 }
 
+// t 在堆上时直接接管它的空间，否则只复制 local 中的几位
 big_uint &big_uint::operator=(big_uint &&t) {
     if (this == &t)
         return *this;
-    delete[] data;
-    len = t.len;
-    capacity = t.capacity;
-    data = t.data;
-    t.len = 0;
-    t.capacity = 0;
-    t.data = nullptr;
+    if (t.data == t.local) {
+        std::fill(data, data + len, 0);
+        std::copy(t.local, t.local + t.len, data);
+        len = t.len;
+        t.release();
+    } else {
+        release();
+        len = t.len;
+        capacity = t.capacity;
+        data = t.data;
+        t.len = 0;
+        t.capacity = INLINE_LIMBS;
+        t.data = t.local;
+    }
     return *this;
 }
 
 big_uint &big_uint::operator=(value_type num) {
-    delete[] data;
-    capacity = 4;
-    data = new value_type[capacity]{0};
+    std::fill(data, data + len, 0);
     len = 0;
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
-        if (len == capacity) {
-            resize(capacity * 2);
-        }
-    }
+    append(num);
     return *this;
 }
 
-big_uint &big_uint::operator=(const std::string &num) {
-    delete[] data;
-    capacity = 4;
-    data = new value_type[capacity]{0};
+big_uint &big_uint::operator=(std::string_view num) {
     copyByString(num);
     return *this;
 }
+template <class Alloc>
+big_uint &big_uint::operator=(const std::basic_string<char, std::char_traits<char>, Alloc> &num) {
+    return *this = std::string_view(num);
+}
 // 输出
+std::string big_uint::to_string() const {
+    std::string s(Decimal::length(data, len), '0');
+    Decimal::to_chars(&s[0], &s[0] + s.size(), data, len);
+    return s;
+}
+std::to_chars_result big_uint::to_chars(char *first, char *last) const {
+    return Decimal::to_chars(first, last, data, len);
+}
 std::ostream &operator<<(std::ostream &os, const big_uint &t) {
-    if (t.len == 0)
-        return os << 0;
-    for (int i = t.len - 1; i >= 0; i--)
-        os << t.data[i];
-    return os;
+    std::string s = t.to_string();
+    return os.write(s.data(), s.size());
 }
 // 算术运算
 big_uint &big_uint::operator+=(const big_uint &t) {
-    len = std::max(len, t.len) + 1;
-    resize(len * 2);
+    resize(std::max(len, t.len) + 1);
+    len = std::max(len, t.len);
     plus(data, t.data, len, t.len);
+    len++;
     while (len && !data[len - 1])
         len--;
     return *this;
@@ -175,7 +269,6 @@ big_uint &big_uint::operator+=(const big_uint &t) {
 
 big_uint &big_uint::operator-=(const big_uint &t) {
     assert(t <= *this);
-    resize(len * 2);
     minus(data, t.data, len, t.len);
     while (len && !data[len - 1])
         len--;
@@ -183,16 +276,142 @@ big_uint &big_uint::operator-=(const big_uint &t) {
 }
 
 big_uint &big_uint::operator*=(const big_uint &t) {
-    resize((len + t.len) * 4);
-    big_uint::multiply(data, t.data, len, t.len, len + t.len > 128);
-    len += t.len;
+    mul(*this, *this, t);
+    return *this;
+}
+big_uint operator+(const big_uint &a, const big_uint &b) { return big_uint(a) + b; }
+big_uint operator-(const big_uint &a, const big_uint &b) { return big_uint(a) - b; }
+// 乘积直接写入新对象，不复制 a
+big_uint operator*(const big_uint &a, const big_uint &b) {
+    big_uint c;
+    mul(c, a, b);
+    return c;
+}
+// 右值版本，结果写在临时对象的空间上，两边都是临时对象时用容量大的一个
+big_uint operator+(big_uint &&a, const big_uint &b) { return std::move(a += b); }
+big_uint operator+(const big_uint &a, big_uint &&b) { return std::move(b += a); }
+big_uint operator+(big_uint &&a, big_uint &&b) {
+    return a.capacity >= b.capacity ? std::move(a += b) : std::move(b += a);
+}
+big_uint operator-(big_uint &&a, const big_uint &b) { return std::move(a -= b); }
+big_uint operator-(const big_uint &a, big_uint &&b) {
+    assert(b <= a);
+    b.resize(a.len);
+    big_uint::minusFrom(b.data, a.data, a.len);
+    b.len = a.len;
+    while (b.len && !b.data[b.len - 1])
+        b.len--;
+    return std::move(b);
+}
+big_uint operator-(big_uint &&a, big_uint &&b) { return std::move(a -= b); }
+big_uint operator*(big_uint &&a, const big_uint &b) { return std::move(a *= b); }
+big_uint operator*(const big_uint &a, big_uint &&b) { return std::move(b *= a); }
+big_uint operator*(big_uint &&a, big_uint &&b) {
+    return a.capacity >= b.capacity ? std::move(a *= b) : std::move(b *= a);
+}
+big_uint operator+(big_uint &&a, int64_t x) { return std::move(a += x); }
+big_uint operator+(int64_t x, big_uint &&a) { return std::move(a += x); }
+big_uint operator-(big_uint &&a, int64_t x) { return std::move(a -= x); }
+big_uint operator*(big_uint &&a, int64_t x) { return std::move(a *= x); }
+big_uint operator*(int64_t x, big_uint &&a) { return std::move(a *= x); }
+// 除法，返回商和余数，除数不能为 0
+std::pair<big_uint, big_uint> divmod(const big_uint &a, const big_uint &b) {
+    assert(b.len);
+    if (big_uint::compareAbs(a, b) < 0)
+        return {big_uint(), a};
+    big_uint q, r;
+    q.resize(a.len - b.len + 1);
+    r.resize(b.len);
+    ::Divide::divide<big_uint::value_type, BIT_LIMIT>(a.data, a.len, b.data, b.len, q.data, r.data);
+    q.len = a.len - b.len + 1;
+    r.len = b.len;
+    while (q.len && !q.data[q.len - 1])
+        q.len--;
+    while (r.len && !r.data[r.len - 1])
+        r.len--;
+    return {std::move(q), std::move(r)};
+}
+big_uint &big_uint::operator/=(const big_uint &t) { return *this = divmod(*this, t).first; }
+big_uint &big_uint::operator%=(const big_uint &t) { return *this = divmod(*this, t).second; }
+big_uint operator/(const big_uint &a, const big_uint &b) { return divmod(a, b).first; }
+big_uint operator%(const big_uint &a, const big_uint &b) { return divmod(a, b).second; }
+// 与单个机器字的运算，一趟完成，除了最高位的进位外不分配内存
+big_uint &big_uint::operator+=(int64_t x) {
+    assert(x >= 0);
+    append(::Scalar::add_1<value_type, BIT_LIMIT>(data, len, x));
+    return *this;
+}
+big_uint &big_uint::operator-=(int64_t x) {
+    assert(x >= 0 && (::Scalar::cmp_1<value_type, BIT_LIMIT>(data, len, x) >= 0));
+    ::Scalar::sub_1<value_type, BIT_LIMIT>(data, len, x);
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+big_uint &big_uint::operator*=(int64_t x) {
+    assert(x >= 0);
+    append(::Scalar::mul_1<value_type, BIT_LIMIT>(data, len, x));
     while (len && !data[len - 1])
         len--;
     return *this;
 }
-big_uint operator+(const big_uint &a, const big_uint &b) { return big_uint(a) += b; }
-big_uint operator-(const big_uint &a, const big_uint &b) { return big_uint(a) -= b; }
-big_uint operator*(const big_uint &a, const big_uint &b) { return big_uint(a) *= b; }
+big_uint &big_uint::operator/=(int64_t x) {
+    assert(x > 0);
+    ::Scalar::div_1<value_type, BIT_LIMIT>(data, len, x);
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+big_uint &big_uint::operator%=(int64_t x) {
+    assert(x > 0);
+    uint64_t r = ::Scalar::mod_1<value_type, BIT_LIMIT>(data, len, x);
+    std::fill(data, data + len, 0);
+    len = 0;
+    append(r);
+    return *this;
+}
+big_uint operator+(const big_uint &a, int64_t x) { return big_uint(a) + x; }
+big_uint operator+(int64_t x, const big_uint &a) { return big_uint(a) + x; }
+big_uint operator-(const big_uint &a, int64_t x) { return big_uint(a) - x; }
+big_uint operator*(const big_uint &a, int64_t x) { return big_uint(a) * x; }
+big_uint operator*(int64_t x, const big_uint &a) { return big_uint(a) * x; }
+big_uint operator/(const big_uint &a, int64_t x) { return std::move(big_uint(a) /= x); }
+int64_t operator%(const big_uint &a, int64_t x) {
+    assert(x > 0);
+    return ::Scalar::mod_1<big_uint::value_type, BIT_LIMIT>(a.data, a.len, x);
+}
+big_uint &big_uint::square() {
+    mul(*this, *this, *this);
+    return *this;
+}
+void mul(big_uint &dst, const big_uint &a, const big_uint &b, Memory::Workspace &ws) {
+    size_t n = a.len + b.len;
+    // 结果直接写入 dst，dst 不是乘数时不必保留原来的值
+    if (&dst != &a && &dst != &b) {
+        std::fill(dst.data, dst.data + dst.len, 0);
+        dst.len = 0;
+    }
+    // 多留一位给随后加法的进位
+    dst.resize(n + 1);
+    ::Multiply::multiply(a.data, a.len, b.data, b.len, dst.data, ws);
+    dst.len = n;
+    while (dst.len && !dst.data[dst.len - 1])
+        dst.len--;
+}
+void mul(big_uint &dst, const big_uint &a, const big_uint &b) { mul(dst, a, b, Memory::workspace()); }
+// 容量缩到恰好 len 位，不超过 INLINE_LIMBS 位时回到对象内
+void big_uint::shrink_to_fit() {
+    if (data == local || capacity == len)
+        return;
+    value_type *old = data;
+    size_t old_capacity = capacity;
+    if (len <= INLINE_LIMBS)
+        data = local, capacity = INLINE_LIMBS;
+    else
+        data = Memory::allocate<value_type>(len), capacity = len;
+    std::copy(old, old + len, data);
+    Memory::deallocate(old, old_capacity);
+}
 std::string big_uint::estimation(size_t sz = 6) {
     if (len == 0)
         return "0";
@@ -206,9 +425,17 @@ std::string big_uint::estimation(size_t sz = 6) {
     s.insert(1, ".");
     return s + "e" + std::to_string(exponent - 1);
 }
+// 先把 a 平方到 b 的最低一位 1，结果从 a 的副本开始，b 为 2 的幂时直接把 a 移出去
 big_uint pow(big_uint a, long long b) {
-    big_uint res(1);
-    for (; b; a *= a, b >>= 1) {
+    if (b == 0)
+        return big_uint(1);
+    for (; !(b & 1); b >>= 1)
+        a.square();
+    if (b == 1)
+        return a;
+    big_uint res = a;
+    while (b >>= 1) {
+        a.square();
         if (b & 1)
             res *= a;
     }
@@ -220,19 +447,21 @@ bool operator!=(const big_uint &a, const big_uint &b) { return !(a == b); }
 bool operator<(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) < 0; }
 bool operator<=(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) <= 0; }
 // 辅助函数
-void big_uint::copyByString(const std::string &num) {
-    if (num.front() == '0' && num.size() == 1) {
-        len = 0;
-    } else {
-        assert(num[0] != '-');
-        size_t n = num.size();
-        len = (n - 1) / BIT_SIZE + 1;
-        resize(len);
-        for (size_t i = 0, j = num.size() - 1; i < n; i++, j--) {
-            assert(num[j] >= '0' && num[j] <= '9');
-            data[i / BIT_SIZE] += (num[j] - '0') * pow10[i % BIT_SIZE];
-        }
-    }
+void big_uint::copyByString(std::string_view num) {
+    auto [ptr, ec] = from_chars(num.data(), num.data() + num.size(), *this);
+    assert(ec == std::errc() && ptr == num.data() + num.size());
+}
+std::from_chars_result from_chars(const char *first, const char *last, big_uint &value) {
+    size_t n = Decimal::digits(first, last);
+    if (n == 0)
+        return {first, std::errc::invalid_argument};
+    size_t old = value.len, l = (n + 3) / 4;
+    value.len = 0;
+    value.resize(l);
+    value.len = Decimal::parse(first, n, value.data);
+    // 原来更长时把多出的部分清零
+    std::fill(value.data + l, value.data + std::max(l, old), 0);
+    return {first + n, std::errc()};
 }
 int big_uint::sgn(value_type x) { return (x > 0) - (x < 0); }
 int big_uint::compareAbs(const big_uint &a, const big_uint &b) {
@@ -246,6 +475,7 @@ int big_uint::compareAbs(const big_uint &a, const big_uint &b) {
     }
 }
 void big_uint::plus(value_type a[], value_type b[], size_t al, size_t bl) {
+    BIG_STATS_SCOPE(big_stats::add, al);
     for (int i = 0; i < al; i++) {
         if (i < bl)
             a[i] += b[i];
@@ -256,6 +486,7 @@ void big_uint::plus(value_type a[], value_type b[], size_t al, size_t bl) {
     }
 }
 void big_uint::minus(value_type a[], value_type b[], size_t al, size_t bl) {
+    BIG_STATS_SCOPE(big_stats::sub, al);
     for (int i = 0; i < al; i++) {
         if (i < bl)
             a[i] -= b[i];
@@ -265,48 +496,14 @@ void big_uint::minus(value_type a[], value_type b[], size_t al, size_t bl) {
         }
     }
 }
-void big_uint::multiply(value_type a[], value_type b[], size_t al, size_t bl, bool ntt) {
-    if (ntt) {
-        size_t len = 2 << std::__lg(al + bl - 1);
-        NTT::CRT *A = new NTT::CRT[len], *B = new NTT::CRT[len];
-        for (int i = 0; i < al; i++)
-            A[i] = NTT::CRT(a[i]);
-        for (int i = 0; i < bl; i++)
-            B[i] = NTT::CRT(b[i]);
-        NTT::NTT(A, len, 1);
-        NTT::NTT(B, len, 1);
-        for (int i = 0; i < len; i++)
-            A[i] = A[i] * B[i];
-        NTT::NTT(A, len, -1);
-        std::fill(a, a + al, 0);
-        const int margin = 20;
-        for (int i = 0; i < len - margin; ++i) {
-            long long val = A[i].get();
-            for (int j = i; val > 0 && j < len; ++j) {
-                a[j] += val % BIT_LIMIT;
-                if (a[j] >= BIT_LIMIT) {
-                    a[j] -= BIT_LIMIT;
-                    a[j + 1] += 1;
-                }
-                val /= BIT_LIMIT;
-            }
-        }
-        delete[] A;
-        delete[] B;
-    } else {
-        if (al == 0 || bl == 0) {
-            std::fill(a, a + al, 0);
-            return;
-        }
-        for (int k = al + bl - 2; k >= 0; k--) {
-            value_type tmp = 0;
-            for (int i = std::min(k, (int)al - 1); i >= 0 && k - i < bl; i--)
-                tmp += a[i] * b[k - i];
-            a[k] = tmp;
-        }
-        for (int i = 0; i < al + bl; i++) {
-            a[i + 1] += a[i] / BIT_LIMIT;
-            a[i] %= BIT_LIMIT;
-        }
+// a[0, bl) = b[0, bl) - a[0, bl)，要求 b >= a
+void big_uint::minusFrom(value_type a[], value_type b[], size_t bl) {
+    BIG_STATS_SCOPE(big_stats::sub, bl);
+    value_type borrow = 0;
+    for (size_t i = 0; i < bl; i++) {
+        a[i] = b[i] - a[i] - borrow;
+        borrow = a[i] < 0;
+        if (borrow)
+            a[i] += BIT_LIMIT;
     }
 }
@@ -0,0 +1,621 @@
+#include "Multiply.h"
+#include "Divide.h"
+#include "Decimal.h"
+#include "Scalar.h"
+#include "Memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// 对象内直接存放的位数，位数更多时才分配堆空间
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 4
+#endif
+
+// 2^32 进制的 big_uint，接口与 BigUIntStd.h 相同
+// 加减法用带进位加法，乘法用 64 位乘积；只在解析和输出时与十进制互相转换，
+// 转换按二分递归，用的是同一套乘法，复杂度为 O(M(n) log n)
+class big_uint {
+  public:
+    using value_type = uint32_t;
+    static constexpr size_t INLINE_LIMBS = BIGINT_INLINE_LIMBS;
+    static_assert(INLINE_LIMBS > 0, "BIGINT_INLINE_LIMBS 至少为 1");
+
+    // 构造函数
+    big_uint();
+    big_uint(const big_uint &t);
+    big_uint(big_uint &&t);
+    big_uint(unsigned long long num);
+    big_uint(std::string_view num);
+    // std::string 需单独重载才能写 big_uint b = s；写成模板，字面量不会匹配它
+    template <class Alloc> big_uint(const std::basic_string<char, std::char_traits<char>, Alloc> &num);
+    big_uint(const char *num, size_t n);
+
+    // 析构函数
+    ~big_uint();
+
+    // 赋值操作符
+    big_uint &operator=(const big_uint &t);
+    big_uint &operator=(big_uint &&t);
+    big_uint &operator=(unsigned long long num);
+    big_uint &operator=(std::string_view num);
+    template <class Alloc>
+    big_uint &operator=(const std::basic_string<char, std::char_traits<char>, Alloc> &num);
+
+    // 输入输出
+    friend std::ostream &operator<<(std::ostream &os, const big_uint &t);
+    std::string to_string() const;
+    std::to_chars_result to_chars(char *first, char *last) const;
+    friend std::from_chars_result from_chars(const char *first, const char *last, big_uint &value);
+
+    // 算术运算
+    big_uint &operator+=(const big_uint &t);
+    friend big_uint operator+(const big_uint &a, const big_uint &b);
+    big_uint &operator-=(const big_uint &t);
+    friend big_uint operator-(const big_uint &a, const big_uint &b);
+    big_uint &operator*=(const big_uint &t);
+    friend big_uint operator*(const big_uint &a, const big_uint &b);
+    big_uint &operator/=(const big_uint &t);
+    friend big_uint operator/(const big_uint &a, const big_uint &b);
+    big_uint &operator%=(const big_uint &t);
+    friend big_uint operator%(const big_uint &a, const big_uint &b);
+    friend std::pair<big_uint, big_uint> divmod(const big_uint &a, const big_uint &b);
+    // 右值版本，结果写在临时对象的空间上
+    friend big_uint operator+(big_uint &&a, const big_uint &b);
+    friend big_uint operator+(const big_uint &a, big_uint &&b);
+    friend big_uint operator+(big_uint &&a, big_uint &&b);
+    friend big_uint operator-(big_uint &&a, const big_uint &b);
+    friend big_uint operator-(const big_uint &a, big_uint &&b);
+    friend big_uint operator-(big_uint &&a, big_uint &&b);
+    friend big_uint operator*(big_uint &&a, const big_uint &b);
+    friend big_uint operator*(const big_uint &a, big_uint &&b);
+    friend big_uint operator*(big_uint &&a, big_uint &&b);
+    friend big_uint operator+(big_uint &&a, int64_t x);
+    friend big_uint operator+(int64_t x, big_uint &&a);
+    friend big_uint operator-(big_uint &&a, int64_t x);
+    friend big_uint operator*(big_uint &&a, int64_t x);
+    friend big_uint operator*(int64_t x, big_uint &&a);
+    // 与单个机器字的运算，x 不能为负
+    big_uint &operator+=(int64_t x);
+    friend big_uint operator+(const big_uint &a, int64_t x);
+    friend big_uint operator+(int64_t x, const big_uint &a);
+    big_uint &operator-=(int64_t x);
+    friend big_uint operator-(const big_uint &a, int64_t x);
+    big_uint &operator*=(int64_t x);
+    friend big_uint operator*(const big_uint &a, int64_t x);
+    friend big_uint operator*(int64_t x, const big_uint &a);
+    big_uint &operator/=(int64_t x);
+    friend big_uint operator/(const big_uint &a, int64_t x);
+    big_uint &operator%=(int64_t x);
+    friend int64_t operator%(const big_uint &a, int64_t x);
+    big_uint &square();
+    // dst = a * b，dst 可以与 a 或 b 相同；乘法的临时空间从 ws 中取用，不指定时用本线程的工作区
+    friend void mul(big_uint &dst, const big_uint &a, const big_uint &b, Memory::Workspace &ws);
+    friend void mul(big_uint &dst, const big_uint &a, const big_uint &b);
+    void shrink_to_fit();
+    std::string estimation(size_t sz);
+
+    // 比较运算
+    friend bool operator==(const big_uint &a, const big_uint &b);
+    friend bool operator!=(const big_uint &a, const big_uint &b);
+    friend bool operator<(const big_uint &a, const big_uint &b);
+    friend bool operator<=(const big_uint &a, const big_uint &b);
+
+  private:
+    // 内部辅助函数
+    void copyByString(std::string_view num);
+    static int compareAbs(const big_uint &a, const big_uint &b);
+    static unsigned char addc(unsigned char c, value_type a, value_type b, value_type *r);
+    static unsigned char subb(unsigned char c, value_type a, value_type b, value_type *r);
+    static void plus(value_type a[], value_type b[], size_t al, size_t bl);
+    static void minus(value_type a[], value_type b[], size_t al, size_t bl);
+    static void minusFrom(value_type a[], value_type b[], size_t bl);
+    static Memory::vector<int> to_decimal(const value_type a[], size_t n);
+    static Memory::vector<value_type> from_decimal(const int d[], size_t m);
+
+    void resize(size_t new_capacity);
+    void release();
+    void assign(const value_type p[], size_t n);
+    void append(uint64_t c);
+
+    // 成员变量
+    size_t len = 0;
+    size_t capacity = INLINE_LIMBS;
+    value_type *data = local;
+    value_type local[INLINE_LIMBS] = {}; // 不超过 INLINE_LIMBS 位时直接存放在对象内，不分配内存
+};
+// 构造函数
+big_uint::big_uint() {}
+
+big_uint::big_uint(const big_uint &t) {
+    assign(t.data, t.len);
+}
+
+big_uint::big_uint(big_uint &&t) { *this = std::move(t); }
+
+big_uint::big_uint(unsigned long long num) { append(num); }
+
+big_uint::big_uint(std::string_view num) { copyByString(num); }
+big_uint::big_uint(const char *num, size_t n) : big_uint(std::string_view(num, n)) {}
+template <class Alloc>
+big_uint::big_uint(const std::basic_string<char, std::char_traits<char>, Alloc> &num)
+    : big_uint(std::string_view(num)) {}
+
+// 析构函数
+big_uint::~big_uint() {
+    if (data != local)
+        Memory::deallocate(data, capacity);
+}
+
+// 容量不足 new_capacity 时换到堆上更大的空间，新空间只清零 len 之后的部分，离开 local 时把它清零
+void big_uint::resize(size_t new_capacity) {
+    if (new_capacity <= capacity)
+        return;
+    value_type *new_data = Memory::allocate<value_type>(new_capacity);
+    std::fill(std::copy(data, data + len, new_data), new_data + new_capacity, 0);
+    if (data == local)
+        std::fill(local, local + INLINE_LIMBS, 0);
+    else
+        Memory::deallocate(data, capacity);
+    data = new_data;
+    capacity = new_capacity;
+}
+// 释放堆上的空间，回到值为 0 的内联状态
+void big_uint::release() {
+    if (data != local)
+        Memory::deallocate(data, capacity);
+    std::fill(local, local + INLINE_LIMBS, 0);
+    data = local;
+    capacity = INLINE_LIMBS;
+    len = 0;
+}
+// 把值设为 p[0, n)，需要换空间时直接申请恰好 n 位且不清零
+void big_uint::assign(const value_type p[], size_t n) {
+    if (n > capacity) {
+        value_type *new_data = Memory::allocate<value_type>(n);
+        if (data == local)
+            std::fill(local, local + INLINE_LIMBS, 0);
+        else
+            Memory::deallocate(data, capacity);
+        data = new_data;
+        capacity = n;
+    } else if (n < len)
+        std::fill(data + n, data + len, 0);
+    std::copy(p, p + n, data);
+    len = n;
+}
+// 把 c 按 32 位一段接在最高位之后
+void big_uint::append(uint64_t c) {
+    for (; c; c >>= 32) {
+        if (len == capacity)
+            resize(capacity * 2);
+        data[len++] = value_type(c);
+    }
+}
+// 赋值运算符，空间足够时不重新分配
+big_uint &big_uint::operator=(const big_uint &t) {
+    if (this == &t)
+        return *this;
+    assign(t.data, t.len);
+    return *this;
+}
+
+// t 在堆上时直接接管它的空间，否则只复制 local 中的几位
+big_uint &big_uint::operator=(big_uint &&t) {
+    if (this == &t)
+        return *this;
+    if (t.data == t.local) {
+        std::fill(data, data + len, 0);
+        std::copy(t.local, t.local + t.len, data);
+        len = t.len;
+        t.release();
+    } else {
+        release();
+        len = t.len;
+        capacity = t.capacity;
+        data = t.data;
+        t.len = 0;
+        t.capacity = INLINE_LIMBS;
+        t.data = t.local;
+    }
+    return *this;
+}
+
+big_uint &big_uint::operator=(unsigned long long num) {
+    std::fill(data, data + len, 0);
+    len = 0;
+    append(num);
+    return *this;
+}
+
+big_uint &big_uint::operator=(std::string_view num) {
+    copyByString(num);
+    return *this;
+}
+template <class Alloc>
+big_uint &big_uint::operator=(const std::basic_string<char, std::char_traits<char>, Alloc> &num) {
+    return *this = std::string_view(num);
+}
+// 输出，先整体转成 10^4 进制
+std::string big_uint::to_string() const {
+    BIG_STATS_SCOPE(big_stats::print, len);
+    Memory::vector<int> d = to_decimal(data, len);
+    std::string s(Decimal::length(d.data(), d.size()), '0');
+    Decimal::to_chars(&s[0], &s[0] + s.size(), d.data(), d.size());
+    return s;
+}
+std::to_chars_result big_uint::to_chars(char *first, char *last) const {
+    BIG_STATS_SCOPE(big_stats::print, len);
+    Memory::vector<int> d = to_decimal(data, len);
+    return Decimal::to_chars(first, last, d.data(), d.size());
+}
+std::ostream &operator<<(std::ostream &os, const big_uint &t) {
+    std::string s = t.to_string();
+    return os.write(s.data(), s.size());
+}
+// 算术运算
+big_uint &big_uint::operator+=(const big_uint &t) {
+    resize(std::max(len, t.len) + 1);
+    len = std::max(len, t.len);
+    plus(data, t.data, len, t.len);
+    len++;
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+
+big_uint &big_uint::operator-=(const big_uint &t) {
+    assert(t <= *this);
+    minus(data, t.data, len, t.len);
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+
+big_uint &big_uint::operator*=(const big_uint &t) {
+    mul(*this, *this, t);
+    return *this;
+}
+big_uint operator+(const big_uint &a, const big_uint &b) { return big_uint(a) + b; }
+big_uint operator-(const big_uint &a, const big_uint &b) { return big_uint(a) - b; }
+// 乘积直接写入新对象，不复制 a
+big_uint operator*(const big_uint &a, const big_uint &b) {
+    big_uint c;
+    mul(c, a, b);
+    return c;
+}
+// 右值版本，结果写在临时对象的空间上，两边都是临时对象时用容量大的一个
+big_uint operator+(big_uint &&a, const big_uint &b) { return std::move(a += b); }
+big_uint operator+(const big_uint &a, big_uint &&b) { return std::move(b += a); }
+big_uint operator+(big_uint &&a, big_uint &&b) {
+    return a.capacity >= b.capacity ? std::move(a += b) : std::move(b += a);
+}
+big_uint operator-(big_uint &&a, const big_uint &b) { return std::move(a -= b); }
+big_uint operator-(const big_uint &a, big_uint &&b) {
+    assert(b <= a);
+    b.resize(a.len);
+    big_uint::minusFrom(b.data, a.data, a.len);
+    b.len = a.len;
+    while (b.len && !b.data[b.len - 1])
+        b.len--;
+    return std::move(b);
+}
+big_uint operator-(big_uint &&a, big_uint &&b) { return std::move(a -= b); }
+big_uint operator*(big_uint &&a, const big_uint &b) { return std::move(a *= b); }
+big_uint operator*(const big_uint &a, big_uint &&b) { return std::move(b *= a); }
+big_uint operator*(big_uint &&a, big_uint &&b) {
+    return a.capacity >= b.capacity ? std::move(a *= b) : std::move(b *= a);
+}
+big_uint operator+(big_uint &&a, int64_t x) { return std::move(a += x); }
+big_uint operator+(int64_t x, big_uint &&a) { return std::move(a += x); }
+big_uint operator-(big_uint &&a, int64_t x) { return std::move(a -= x); }
+big_uint operator*(big_uint &&a, int64_t x) { return std::move(a *= x); }
+big_uint operator*(int64_t x, big_uint &&a) { return std::move(a *= x); }
+// 除法，返回商和余数，除数不能为 0
+std::pair<big_uint, big_uint> divmod(const big_uint &a, const big_uint &b) {
+    assert(b.len);
+    if (big_uint::compareAbs(a, b) < 0)
+        return {big_uint(), a};
+    big_uint q, r;
+    q.resize(a.len - b.len + 1);
+    r.resize(b.len);
+    ::Divide::divide<big_uint::value_type, uint64_t(1) << 32>(a.data, a.len, b.data, b.len, q.data, r.data);
+    q.len = a.len - b.len + 1;
+    r.len = b.len;
+    while (q.len && !q.data[q.len - 1])
+        q.len--;
+    while (r.len && !r.data[r.len - 1])
+        r.len--;
+    return {std::move(q), std::move(r)};
+}
+big_uint &big_uint::operator/=(const big_uint &t) { return *this = divmod(*this, t).first; }
+big_uint &big_uint::operator%=(const big_uint &t) { return *this = divmod(*this, t).second; }
+big_uint operator/(const big_uint &a, const big_uint &b) { return divmod(a, b).first; }
+big_uint operator%(const big_uint &a, const big_uint &b) { return divmod(a, b).second; }
+// 与单个机器字的运算，一趟完成，除了最高位的进位外不分配内存
+big_uint &big_uint::operator+=(int64_t x) {
+    assert(x >= 0);
+    append(::Scalar::add_1<value_type, uint64_t(1) << 32>(data, len, x));
+    return *this;
+}
+big_uint &big_uint::operator-=(int64_t x) {
+    assert(x >= 0 && (::Scalar::cmp_1<value_type, uint64_t(1) << 32>(data, len, x) >= 0));
+    ::Scalar::sub_1<value_type, uint64_t(1) << 32>(data, len, x);
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+big_uint &big_uint::operator*=(int64_t x) {
+    assert(x >= 0);
+    append(::Scalar::mul_1<value_type, uint64_t(1) << 32>(data, len, x));
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+big_uint &big_uint::operator/=(int64_t x) {
+    assert(x > 0);
+    ::Scalar::div_1<value_type, uint64_t(1) << 32>(data, len, x);
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+big_uint &big_uint::operator%=(int64_t x) {
+    assert(x > 0);
+    uint64_t r = ::Scalar::mod_1<value_type, uint64_t(1) << 32>(data, len, x);
+    std::fill(data, data + len, 0);
+    len = 0;
+    append(r);
+    return *this;
+}
+big_uint operator+(const big_uint &a, int64_t x) { return big_uint(a) + x; }
+big_uint operator+(int64_t x, const big_uint &a) { return big_uint(a) + x; }
+big_uint operator-(const big_uint &a, int64_t x) { return big_uint(a) - x; }
+big_uint operator*(const big_uint &a, int64_t x) { return big_uint(a) * x; }
+big_uint operator*(int64_t x, const big_uint &a) { return big_uint(a) * x; }
+big_uint operator/(const big_uint &a, int64_t x) { return std::move(big_uint(a) /= x); }
+int64_t operator%(const big_uint &a, int64_t x) {
+    assert(x > 0);
+    return ::Scalar::mod_1<big_uint::value_type, uint64_t(1) << 32>(a.data, a.len, x);
+}
+big_uint &big_uint::square() {
+    mul(*this, *this, *this);
+    return *this;
+}
+void mul(big_uint &dst, const big_uint &a, const big_uint &b, Memory::Workspace &ws) {
+    size_t n = a.len + b.len;
+    // 结果直接写入 dst，dst 不是乘数时不必保留原来的值
+    if (&dst != &a && &dst != &b) {
+        std::fill(dst.data, dst.data + dst.len, 0);
+        dst.len = 0;
+    }
+    // 多留一位给随后加法的进位
+    dst.resize(n + 1);
+    ::Multiply::multiply(a.data, a.len, b.data, b.len, dst.data, ws);
+    dst.len = n;
+    while (dst.len && !dst.data[dst.len - 1])
+        dst.len--;
+}
+void mul(big_uint &dst, const big_uint &a, const big_uint &b) { mul(dst, a, b, Memory::workspace()); }
+// 容量缩到恰好 len 位，不超过 INLINE_LIMBS 位时回到对象内
+void big_uint::shrink_to_fit() {
+    if (data == local || capacity == len)
+        return;
+    value_type *old = data;
+    size_t old_capacity = capacity;
+    if (len <= INLINE_LIMBS)
+        data = local, capacity = INLINE_LIMBS;
+    else
+        data = Memory::allocate<value_type>(len), capacity = len;
+    std::copy(old, old + len, data);
+    Memory::deallocate(old, old_capacity);
+}
+std::string big_uint::estimation(size_t sz = 6) {
+    if (len == 0)
+        return "0";
+    std::string s = to_string();
+    size_t exponent = s.size();
+    s.resize(std::min(sz, s.size()));
+    s.insert(1, ".");
+    return s + "e" + std::to_string(exponent - 1);
+}
+// 先把 a 平方到 b 的最低一位 1，结果从 a 的副本开始，b 为 2 的幂时直接把 a 移出去
+big_uint pow(big_uint a, long long b) {
+    if (b == 0)
+        return big_uint(1);
+    for (; !(b & 1); b >>= 1)
+        a.square();
+    if (b == 1)
+        return a;
+    big_uint res = a;
+    while (b >>= 1) {
+        a.square();
+        if (b & 1)
+            res *= a;
+    }
+    return res;
+}
+// 比较运算
+bool operator==(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) == 0; }
+bool operator!=(const big_uint &a, const big_uint &b) { return !(a == b); }
+bool operator<(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) < 0; }
+bool operator<=(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) <= 0; }
+// 辅助函数
+void big_uint::copyByString(std::string_view num) {
+    auto [ptr, ec] = from_chars(num.data(), num.data() + num.size(), *this);
+    assert(ec == std::errc() && ptr == num.data() + num.size());
+}
+std::from_chars_result from_chars(const char *first, const char *last, big_uint &value) {
+    size_t n = Decimal::digits(first, last);
+    if (n == 0)
+        return {first, std::errc::invalid_argument};
+    // 计时包含转换为 2^32 进制的部分，其中的乘法另外计入 mul
+    BIG_STATS_SCOPE(big_stats::parse, (n + 3) / 4);
+    Memory::vector<int> d((n + 3) / 4);
+    Memory::vector<big_uint::value_type> b = big_uint::from_decimal(d.data(), Decimal::parse(first, n, d.data()));
+    size_t old = value.len, l = b.size();
+    value.len = 0;
+    value.resize(l);
+    std::copy(b.begin(), b.end(), value.data);
+    value.len = l;
+    // 原来更长时把多出的部分清零
+    std::fill(value.data + l, value.data + std::max(l, old), 0);
+    return {first + n, std::errc()};
+}
+int big_uint::compareAbs(const big_uint &a, const big_uint &b) {
+    if (a.len != b.len)
+        return a.len < b.len ? -1 : 1;
+    for (size_t i = a.len; i-- > 0;)
+        if (a.data[i] != b.data[i])
+            return a.data[i] < b.data[i] ? -1 : 1;
+    return 0;
+}
+// r = a + b + c，返回新的进位；x86 上直接对应 adc 指令
+unsigned char big_uint::addc(unsigned char c, value_type a, value_type b, value_type *r) {
+#if defined(__x86_64__) || defined(__i386__)
+    return _addcarry_u32(c, a, b, r);
+#else
+    uint64_t s = uint64_t(a) + b + c;
+    *r = value_type(s);
+    return s >> 32;
+#endif
+}
+// r = a - b - c，返回新的借位；x86 上直接对应 sbb 指令
+unsigned char big_uint::subb(unsigned char c, value_type a, value_type b, value_type *r) {
+#if defined(__x86_64__) || defined(__i386__)
+    return _subborrow_u32(c, a, b, r);
+#else
+    uint64_t s = uint64_t(a) - b - c;
+    *r = value_type(s);
+    return s >> 63;
+#endif
+}
+// a[0, al] += b[0, bl)，要求 al >= bl 且 a[al] 可写
+void big_uint::plus(value_type a[], value_type b[], size_t al, size_t bl) {
+    BIG_STATS_SCOPE(big_stats::add, al);
+    unsigned char c = 0;
+    size_t i = 0;
+    for (; i < bl; i++)
+        c = addc(c, a[i], b[i], &a[i]);
+    for (; c && i < al; i++)
+        c = addc(c, a[i], 0, &a[i]);
+    a[al] += c;
+}
+// a[0, al) -= b[0, bl)，要求 a >= b
+void big_uint::minus(value_type a[], value_type b[], size_t al, size_t bl) {
+    BIG_STATS_SCOPE(big_stats::sub, al);
+    unsigned char c = 0;
+    size_t i = 0;
+    for (; i < bl; i++)
+        c = subb(c, a[i], b[i], &a[i]);
+    for (; c && i < al; i++)
+        c = subb(c, a[i], 0, &a[i]);
+}
+// a[0, bl) = b[0, bl) - a[0, bl)，要求 b >= a
+void big_uint::minusFrom(value_type a[], value_type b[], size_t bl) {
+    BIG_STATS_SCOPE(big_stats::sub, bl);
+    unsigned char c = 0;
+    for (size_t i = 0; i < bl; i++)
+        c = subb(c, b[i], a[i], &a[i]);
+}
+// 2^32 进制转 10^4 进制：a = hi * 2^(32k) + lo，k 取小于 n 的最大 2 的幂，
+// 两半分别转换后用 10^4 进制的乘法合并；位数较少时反复除以 10^8
+Memory::vector<int> big_uint::to_decimal(const value_type a[], size_t n) {
+    // pw[j] 为 2^(32 * 2^j) 的 10^4 进制表示
+    Memory::vector<Memory::vector<int>> pw{{7296, 9496, 42}};
+    while (n > 1 && pw.size() <= size_t(std::__lg(n - 1))) {
+        const Memory::vector<int> &p = pw.back();
+        Memory::vector<int> q(p.size() * 2);
+        ::Multiply::multiply(p.data(), p.size(), p.data(), p.size(), q.data());
+        while (!q.back())
+            q.pop_back();
+        pw.push_back(std::move(q));
+    }
+    auto convert = [&](auto &self, const value_type a[], size_t n) -> Memory::vector<int> {
+        while (n && !a[n - 1])
+            n--;
+        Memory::vector<int> r;
+        if (n <= 32) {
+            value_type t[32];
+            std::copy(a, a + n, t);
+            while (n) {
+                uint64_t rem = 0;
+                for (size_t i = n; i-- > 0;) {
+                    uint64_t cur = rem << 32 | t[i];
+                    t[i] = value_type(cur / 100000000);
+                    rem = cur % 100000000;
+                }
+                r.push_back(rem % 10000);
+                r.push_back(rem / 10000);
+                while (n && !t[n - 1])
+                    n--;
+            }
+        } else {
+            size_t k = size_t(1) << std::__lg(n - 1);
+            Memory::vector<int> lo = self(self, a, k), hi = self(self, a + k, n - k);
+            const Memory::vector<int> &p = pw[std::__lg(k)];
+            r.resize(std::max(hi.size() + p.size(), lo.size()) + 1);
+            ::Multiply::multiply(hi.data(), hi.size(), p.data(), p.size(), r.data());
+            int carry = 0;
+            for (size_t i = 0; i < lo.size() || carry; i++) {
+                r[i] += (i < lo.size() ? lo[i] : 0) + carry;
+                carry = r[i] >= 10000;
+                r[i] -= carry * 10000;
+            }
+        }
+        while (!r.empty() && !r.back())
+            r.pop_back();
+        return r;
+    };
+    return convert(convert, a, n);
+}
+// 10^4 进制转 2^32 进制：d = hi * 10^(4k) + lo，做法与 to_decimal 对称；位数较少时按秦九韶算法
+Memory::vector<big_uint::value_type> big_uint::from_decimal(const int d[], size_t m) {
+    // pw[j] 为 10^(4 * 2^j) 的 2^32 进制表示
+    Memory::vector<Memory::vector<value_type>> pw{{10000}};
+    while (m > 1 && pw.size() <= size_t(std::__lg(m - 1))) {
+        const Memory::vector<value_type> &p = pw.back();
+        Memory::vector<value_type> q(p.size() * 2);
+        ::Multiply::multiply(p.data(), p.size(), p.data(), p.size(), q.data());
+        while (!q.back())
+            q.pop_back();
+        pw.push_back(std::move(q));
+    }
+    auto convert = [&](auto &self, const int d[], size_t m) -> Memory::vector<value_type> {
+        while (m && !d[m - 1])
+            m--;
+        Memory::vector<value_type> r;
+        if (m <= 64) {
+            for (size_t i = m; i-- > 0;) {
+                uint64_t carry = d[i];
+                for (value_type &x : r) {
+                    carry += uint64_t(x) * 10000;
+                    x = value_type(carry);
+                    carry >>= 32;
+                }
+                if (carry)
+                    r.push_back(value_type(carry));
+            }
+        } else {
+            size_t k = size_t(1) << std::__lg(m - 1);
+            Memory::vector<value_type> lo = self(self, d, k), hi = self(self, d + k, m - k);
+            const Memory::vector<value_type> &p = pw[std::__lg(k)];
+            r.resize(std::max(hi.size() + p.size(), lo.size()) + 1);
+            ::Multiply::multiply(hi.data(), hi.size(), p.data(), p.size(), r.data());
+            plus(r.data(), lo.data(), r.size() - 1, lo.size());
+        }
+        while (!r.empty() && !r.back())
+            r.pop_back();
+        return r;
+    };
+    return convert(convert, d, m);
+}
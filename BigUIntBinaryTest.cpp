@@ -0,0 +1,11 @@
+#include "BigUIntBinary.h"
+#include "test.h"
+
+#include <iostream>
+
+int main() {
+    test<big_uint>();
+    edgetest<big_uint>();
+    randtest<big_uint>();
+    return 0;
+}
@@ -1,165 +1,227 @@
+#include "Multiply.h"
+#include "Decimal.h"
+
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <random>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
-const size_t pow10[19] = {1, 10, 100, 1000, 10000};
-const size_t MAX_SIZE = 1024 * 1024 * 1024;
-const size_t BIT_SIZE = 4;
-const size_t BIT_LIMIT = pow10[BIT_SIZE]; // MAX_SIZE * BIT_SIZE <= 2^64
-const int P = 998244353;
+// big_uint 的位数上限（10^4 进制），即 fixed_big_uint<BIGINT_STATIC_LIMBS>
+#ifndef BIGINT_STATIC_LIMBS
+#define BIGINT_STATIC_LIMBS 1024
+#endif
+// Limbs 不超过此值时运行时的乘法只用栈上的草稿区（约 80 * Limbs 字节），不用 NTT，也不分配内存；
+// 更大时草稿区放不进栈，改用 Multiply::multiply，其中的工作区与 NTT 会分配堆空间
+#ifndef BIGINT_STATIC_STACK_LIMBS
+#define BIGINT_STATIC_STACK_LIMBS 2048
+#endif
+
+// C++20 起构造、赋值、加减乘、乘方与比较都是 constexpr，可以在编译期求值
+#ifndef BIGINT_STATIC_CONSTEXPR
+#if __cplusplus >= 202002L
+#define BIGINT_STATIC_CONSTEXPR constexpr
+#define BIGINT_STATIC_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+#define BIGINT_STATIC_CONSTEXPR
+#define BIGINT_STATIC_CONSTANT_EVALUATED() false
+#endif
+#endif
 
-class big_uint {
+// 定长无符号大整数：至多 Limbs 个 10^4 进制位，存放在对象内的 std::array 中，不分配堆空间
+// 只有 data[0, len) 有意义，复制时只复制这一段；结果超过 Limbs 位时 assert 失败
+// 乘法的草稿区在栈上，Limbs 超过 BIGINT_STATIC_STACK_LIMBS 时例外
+// 编译期求值时整个 data 都会初始化，乘法改用朴素乘法，字符串逐个字符解析
+template <size_t Limbs> class fixed_big_uint {
   public:
     using value_type = int;
+    static constexpr size_t MAX_SIZE = Limbs;
+    static constexpr size_t BIT_SIZE = 4;
+    static constexpr value_type BIT_LIMIT = 10000;
+    static_assert(Limbs > 0, "Limbs 至少为 1");
 
     // 构造函数
-    big_uint();
-    big_uint(const big_uint &t);
-    big_uint(big_uint &&t);
-    big_uint(value_type num);
-    big_uint(const std::string &num);
-
-    // 析构函数
-    ~big_uint();
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint();
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint(const fixed_big_uint &t);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint(value_type num);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint(std::string_view num);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint(const char *num, size_t n);
 
     // 赋值操作符
-    big_uint &operator=(const big_uint &t);
-    big_uint &operator=(big_uint &&t);
-    big_uint &operator=(value_type num);
-    big_uint &operator=(const std::string &num);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint &operator=(const fixed_big_uint &t);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint &operator=(value_type num);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint &operator=(std::string_view num);
 
     // 输入输出
-    friend std::ostream &operator<<(std::ostream &os, const big_uint &t);
+    template <size_t N> friend std::ostream &operator<<(std::ostream &os, const fixed_big_uint<N> &t);
+    std::string to_string() const;
+    std::to_chars_result to_chars(char *first, char *last) const;
+    template <size_t N>
+    friend std::from_chars_result from_chars(const char *first, const char *last, fixed_big_uint<N> &value);
 
     // 算术运算
-    big_uint &operator+=(const big_uint &t);
-    friend big_uint operator+(const big_uint &a, const big_uint &b);
-    big_uint &operator-=(const big_uint &t);
-    friend big_uint operator-(const big_uint &a, const big_uint &b);
-    big_uint &operator*=(const big_uint &t);
-    friend big_uint operator*(const big_uint &a, const big_uint &b);
-    std::string estimation(size_t sz);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint &operator+=(const fixed_big_uint &t);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint &operator-=(const fixed_big_uint &t);
+    BIGINT_STATIC_CONSTEXPR fixed_big_uint &operator*=(const fixed_big_uint &t);
+    std::string estimation(size_t sz = 6);
 
     // 比较运算
-    friend bool operator==(const big_uint &a, const big_uint &b);
-    friend bool operator!=(const big_uint &a, const big_uint &b);
-    friend bool operator<(const big_uint &a, const big_uint &b);
-    friend bool operator<=(const big_uint &a, const big_uint &b);
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR bool operator==(const fixed_big_uint<N> &a, const fixed_big_uint<N> &b);
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR bool operator<(const fixed_big_uint<N> &a, const fixed_big_uint<N> &b);
+    template <size_t N>
+    friend BIGINT_STATIC_CONSTEXPR bool operator<=(const fixed_big_uint<N> &a, const fixed_big_uint<N> &b);
 
   private:
     // 内部辅助函数
-    void copyByString(const std::string &num);
-    static int sgn(value_type x);
-    static int compareAbs(const big_uint &a, const big_uint &b);
-    static void plus(value_type a[], value_type b[], size_t l);
-    static void minus(value_type a[], value_type b[], size_t l);
-    static void multiply(value_type a[], value_type b[], size_t al, size_t bl, bool ntt);
-    static void NTT(value_type a[], size_t n, int inv);
-    static int ksm(int a, int b, int P);
-    static int inv(int a, int P);
-
-    void resize(size_t new_capacity);
+    BIGINT_STATIC_CONSTEXPR void copyByString(std::string_view num);
+    static BIGINT_STATIC_CONSTEXPR int compareAbs(const fixed_big_uint &a, const fixed_big_uint &b);
+    static BIGINT_STATIC_CONSTEXPR void multiplyBasecase(const value_type a[], size_t al, const value_type b[],
+                                                         size_t bl, value_type c[]);
+    static void multiplyRuntime(const value_type a[], size_t al, const value_type b[], size_t bl,
+                                value_type c[]);
 
     // 成员变量
     size_t len = 0;
-    value_type *data = nullptr;
+    std::array<value_type, Limbs> data;
 };
+using big_uint = fixed_big_uint<BIGINT_STATIC_LIMBS>;
+
 // 构造函数
-big_uint::big_uint() : data(new value_type[MAX_SIZE]{0}) {}
-big_uint::big_uint(const big_uint &t) : len(t.len), data(new value_type[MAX_SIZE]{0}) {
-    std::copy(t.data, t.data + t.len, data);
+template <size_t Limbs> BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs>::fixed_big_uint() {
+    if (BIGINT_STATIC_CONSTANT_EVALUATED())
+        data.fill(0);
 }
-big_uint::big_uint(big_uint &&t) : len(t.len), data(t.data) {
-    t.len = 0;
-    t.data = nullptr;
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs>::fixed_big_uint(const fixed_big_uint &t) : fixed_big_uint() {
+    *this = t;
 }
-big_uint::big_uint(value_type num) : len(0), data(new value_type[MAX_SIZE]{0}) {
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
-    }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs>::fixed_big_uint(value_type num) : fixed_big_uint() {
+    *this = num;
 }
-big_uint::big_uint(const std::string &num) : data(new value_type[MAX_SIZE]{0}) {
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs>::fixed_big_uint(std::string_view num) : fixed_big_uint() {
     copyByString(num);
 }
-// 析构函数
-big_uint::~big_uint() { delete[] data; }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs>::fixed_big_uint(const char *num, size_t n)
+    : fixed_big_uint(std::string_view(num, n)) {}
 // 赋值运算符
-big_uint &big_uint::operator=(const big_uint &t) {
-    if (this == &t)
-        return *this;
-    delete[] data;
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> &fixed_big_uint<Limbs>::operator=(const fixed_big_uint &t) {
     len = t.len;
-    data = new value_type[MAX_SIZE]{0};
-    std::copy(t.data, t.data + t.len, data);
+    std::copy(t.data.begin(), t.data.begin() + t.len, data.begin());
     return *this;
 }
-big_uint &big_uint::operator=(big_uint &&t) {
-    if (this == &t)
-        return *this;
-    delete[] data;
-    len = t.len;
-    data = t.data;
-    t.len = 0;
-    t.data = nullptr;
-    return *this;
-}
-big_uint &big_uint::operator=(value_type num) {
-    delete[] data;
-    data = new value_type[MAX_SIZE]{0};
-    len = 0;
-    while (num) {
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> &fixed_big_uint<Limbs>::operator=(value_type num) {
+    assert(num >= 0);
+    for (len = 0; num; num /= BIT_LIMIT) {
+        assert(len < Limbs);
         data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
     }
     return *this;
 }
-big_uint &big_uint::operator=(const std::string &num) {
-    delete[] data;
-    data = new value_type[MAX_SIZE]{0};
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> &fixed_big_uint<Limbs>::operator=(std::string_view num) {
     copyByString(num);
     return *this;
 }
 // 输出
-std::ostream &operator<<(std::ostream &os, const big_uint &t) {
-    if (t.len == 0)
-        return os << 0;
-    for (int i = t.len - 1; i >= 0; i--)
-        os << t.data[i];
-    return os;
+template <size_t Limbs> std::string fixed_big_uint<Limbs>::to_string() const {
+    std::string s(Decimal::length(data.data(), len), '0');
+    Decimal::to_chars(&s[0], &s[0] + s.size(), data.data(), len);
+    return s;
 }
-// 算术运算
-big_uint &big_uint::operator+=(const big_uint &t) {
-    len = std::max(len, t.len) + 1;
-    plus(data, t.data, len);
-    while (len && !data[len - 1])
-        len--;
+template <size_t Limbs> std::to_chars_result fixed_big_uint<Limbs>::to_chars(char *first, char *last) const {
+    return Decimal::to_chars(first, last, data.data(), len);
+}
+template <size_t Limbs> std::ostream &operator<<(std::ostream &os, const fixed_big_uint<Limbs> &t) {
+    std::string s = t.to_string();
+    return os.write(s.data(), s.size());
+}
+// 算术运算，t 可以是 *this 本身
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> &fixed_big_uint<Limbs>::operator+=(const fixed_big_uint &t) {
+    size_t n = std::max(len, t.len);
+    std::fill(data.begin() + len, data.begin() + n, 0);
+    value_type carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        data[i] += (i < t.len ? t.data[i] : 0) + carry;
+        carry = data[i] >= BIT_LIMIT;
+        if (carry)
+            data[i] -= BIT_LIMIT;
+    }
+    len = n;
+    if (carry) {
+        assert(len < Limbs);
+        data[len++] = 1;
+    }
     return *this;
 }
-big_uint &big_uint::operator-=(const big_uint &t) {
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> &fixed_big_uint<Limbs>::operator-=(const fixed_big_uint &t) {
     assert(t <= *this);
-    minus(data, t.data, len);
+    value_type borrow = 0;
+    for (size_t i = 0; i < len && (i < t.len || borrow); i++) {
+        data[i] -= (i < t.len ? t.data[i] : 0) + borrow;
+        borrow = data[i] < 0;
+        if (borrow)
+            data[i] += BIT_LIMIT;
+    }
     while (len && !data[len - 1])
         len--;
     return *this;
 }
-big_uint &big_uint::operator*=(const big_uint &t) {
-    assert((len + t.len) * 2 <= MAX_SIZE);
-    big_uint::multiply(data, t.data, len, t.len, len + t.len > 128);
-    len += t.len;
-    while (len && !data[len - 1])
-        len--;
+// 乘积直接写入 data，两个乘数都不被修改；去掉最高位的 0 后超过 Limbs 位时 assert 失败
+// 乘积至少有 len + t.len - 1 位，len + t.len 恰好为 Limbs + 1 时先写入 spill，看最高位是否为 0
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> &fixed_big_uint<Limbs>::operator*=(const fixed_big_uint &t) {
+    if (!len || !t.len) {
+        len = 0;
+        return *this;
+    }
+    size_t n = len + t.len;
+    assert(n - 1 <= Limbs);
+    std::array<value_type, Limbs + 1> spill;
+    value_type *c = n <= Limbs ? data.data() : spill.data();
+    if (BIGINT_STATIC_CONSTANT_EVALUATED())
+        multiplyBasecase(data.data(), len, t.data.data(), t.len, c);
+    else
+        multiplyRuntime(data.data(), len, t.data.data(), t.len, c);
+    while (n && !c[n - 1])
+        n--;
+    assert(n <= Limbs);
+    if (c != data.data())
+        std::copy(c, c + n, data.begin());
+    len = n;
     return *this;
 }
-big_uint operator+(const big_uint &a, const big_uint &b) { return big_uint(a) += b; }
-big_uint operator-(const big_uint &a, const big_uint &b) { return big_uint(a) -= b; }
-big_uint operator*(const big_uint &a, const big_uint &b) { return big_uint(a) *= b; }
-std::string big_uint::estimation(size_t sz = 6) {
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> operator+(const fixed_big_uint<Limbs> &a,
+                                                        const fixed_big_uint<Limbs> &b) {
+    return fixed_big_uint<Limbs>(a) += b;
+}
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> operator-(const fixed_big_uint<Limbs> &a,
+                                                        const fixed_big_uint<Limbs> &b) {
+    return fixed_big_uint<Limbs>(a) -= b;
+}
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> operator*(const fixed_big_uint<Limbs> &a,
+                                                        const fixed_big_uint<Limbs> &b) {
+    return fixed_big_uint<Limbs>(a) *= b;
+}
+template <size_t Limbs> std::string fixed_big_uint<Limbs>::estimation(size_t sz) {
     if (len == 0)
         return "0";
     std::string s = std::to_string(data[len - 1]);
@@ -172,113 +234,122 @@ std::string big_uint::estimation(size_t sz = 6) {
     s.insert(1, ".");
     return s + "e" + std::to_string(exponent - 1);
 }
-big_uint pow(big_uint a, long long b) {
-    big_uint res(1);
-    for (; b; a *= a, b >>= 1) {
+// 最后一次平方不再计算，避免结果之外的部分越界
+template <size_t Limbs> BIGINT_STATIC_CONSTEXPR fixed_big_uint<Limbs> pow(fixed_big_uint<Limbs> a, long long b) {
+    fixed_big_uint<Limbs> res(1);
+    for (; b; b >>= 1) {
         if (b & 1)
             res *= a;
+        if (b > 1)
+            a *= a;
     }
     return res;
 }
 // 比较运算
-bool operator==(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) == 0; }
-bool operator!=(const big_uint &a, const big_uint &b) { return !(a == b); }
-bool operator<(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) < 0; }
-bool operator<=(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) <= 0; }
-// 辅助函数
-void big_uint::copyByString(const std::string &num) {
-    if (num.front() == '0' && num.size() == 1) {
-        len = 0;
-    } else {
-        assert(num[0] != '-');
-        size_t n = num.size();
-        len = (n - 1) / BIT_SIZE + 1;
-        for (size_t i = 0, j = num.size() - 1; i < n; i++, j--) {
-            assert(num[j] >= '0' && num[j] <= '9');
-            data[i / BIT_SIZE] += (num[j] - '0') * pow10[i % BIT_SIZE];
-        }
-    }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR bool operator==(const fixed_big_uint<Limbs> &a, const fixed_big_uint<Limbs> &b) {
+    return fixed_big_uint<Limbs>::compareAbs(a, b) == 0;
 }
-int big_uint::sgn(value_type x) { return (x > 0) - (x < 0); }
-int big_uint::compareAbs(const big_uint &a, const big_uint &b) {
-    if (a.len == b.len) {
-        for (int i = a.len - 1; i >= 0; i--)
-            if (a.data[i] != b.data[i])
-                return sgn(a.data[i] - b.data[i]);
-        return 0;
-    } else {
-        return sgn(a.len - b.len);
-    }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR bool operator!=(const fixed_big_uint<Limbs> &a, const fixed_big_uint<Limbs> &b) {
+    return !(a == b);
 }
-void big_uint::plus(value_type a[], value_type b[], size_t l) {
-    for (int i = 0; i < l; i++) {
-        a[i] += b[i];
-        if (a[i] >= BIT_LIMIT) {
-            a[i + 1]++;
-            a[i] -= BIT_LIMIT;
-        }
-    }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR bool operator<(const fixed_big_uint<Limbs> &a, const fixed_big_uint<Limbs> &b) {
+    return fixed_big_uint<Limbs>::compareAbs(a, b) < 0;
 }
-void big_uint::minus(value_type a[], value_type b[], size_t l) {
-    for (int i = 0; i < l; i++) {
-        a[i] -= b[i];
-        if (a[i] < 0) {
-            a[i + 1]--;
-            a[i] += BIT_LIMIT;
-        }
-    }
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR bool operator<=(const fixed_big_uint<Limbs> &a, const fixed_big_uint<Limbs> &b) {
+    return fixed_big_uint<Limbs>::compareAbs(a, b) <= 0;
 }
-void big_uint::multiply(value_type a[], value_type b[], size_t al, size_t bl, bool ntt) {
-    if (ntt) {
-        size_t n = al + bl, len = 2 << std::__lg(n - 1);
-        NTT(a, len, 1);
-        NTT(b, len, 1);
-        for (int i = 0; i < len; i++)
-            a[i] = 1LL * a[i] * b[i] % P;
-        NTT(a, len, -1);
-        NTT(b, len, -1);
-    } else {
-        for (int k = al + bl - 2; k >= 0; k--) {
-            value_type tmp = 0;
-            for (int i = std::min(k, (int)al - 1); i >= 0 && k - i < bl; i--)
-                tmp += a[i] * b[k - i];
-            a[k] = tmp;
-        }
-    }
-    for (int i = 0; i < al + bl; i++) {
-        a[i + 1] += a[i] / BIT_LIMIT;
-        a[i] %= BIT_LIMIT;
-    }
+// 字面量：123456789012345678901234567890_big
+// 只接受不带前导零的十进制数字，带 ' 分隔符、十六进制或八进制形式的字面量在编译时报错
+// C++20 起值保存在 big_uint_literal 中，在编译期解析并放进只读数据段，运行时不再解析；
+// C++17 下变量模板的动态初始化之间没有确定的顺序，因此每次按值返回，在运行时解析
+template <char... C> constexpr bool big_uint_literal_digits = ((C >= '0' && C <= '9') && ...);
+// 以 0 开头的整数字面量在 C++ 中是八进制，为避免误读，除 0_big 外不允许前导零
+template <char C0, char... C> constexpr bool big_uint_literal_leading_zero = C0 == '0' && sizeof...(C) > 0;
+#if __cplusplus >= 202002L
+template <char... C>
+constexpr big_uint big_uint_literal =
+    big_uint(std::string_view(std::array<char, sizeof...(C)>{C...}.data(), sizeof...(C)));
+template <char... C> constexpr const big_uint &operator""_big() {
+    static_assert(big_uint_literal_digits<C...>, "_big 字面量只能由十进制数字组成");
+    static_assert(!big_uint_literal_leading_zero<C...>, "_big 字面量不能有前导零");
+    return big_uint_literal<C...>;
 }
-int big_uint::ksm(int a, int b, int P) {
-    int s = 1;
-    for (; b; b >>= 1, a = 1LL * a * a % P)
-        if (b & 1)
-            s = 1LL * s * a % P;
-    return s;
+#else
+template <char... C> big_uint operator""_big() {
+    static_assert(big_uint_literal_digits<C...>, "_big 字面量只能由十进制数字组成");
+    static_assert(!big_uint_literal_leading_zero<C...>, "_big 字面量不能有前导零");
+    return big_uint(std::string_view(std::array<char, sizeof...(C)>{C...}.data(), sizeof...(C)));
 }
-int big_uint::inv(int a, int P) { return big_uint::ksm(a, P - 2, P); }
-void big_uint::NTT(value_type a[], size_t n, int inv) {
-    std::vector<size_t> rev(n);
-    for (size_t i = 0; i < n; i++) {
-        rev[i] = (rev[i >> 1] >> 1) | ((i & 1) << std::__lg(n >> 1));
-        if (i < rev[i])
-            std::swap(a[i], a[rev[i]]);
+#endif
+// 辅助函数
+// 编译期逐个字符解析，运行时交给 from_chars
+template <size_t Limbs> BIGINT_STATIC_CONSTEXPR void fixed_big_uint<Limbs>::copyByString(std::string_view num) {
+    if (BIGINT_STATIC_CONSTANT_EVALUATED()) {
+        for (char c : num)
+            assert(c >= '0' && c <= '9');
+        // 前导零不占位数
+        while (num.size() > 1 && num[0] == '0')
+            num.remove_prefix(1);
+        assert(!num.empty() && (num.size() + 3) / 4 <= Limbs);
+        len = Decimal::parse_constexpr(num.data(), num.size(), data.data());
+        return;
     }
-    for (size_t i = 2; i <= n; i <<= 1) {
-        int gn = ksm(inv == 1 ? 3 : big_uint::inv(3, P), (P - 1) / i, P);
-        for (size_t j = 0; j < n; j += i) {
-            int g0 = 1;
-            for (size_t k = j; k < j + i / 2; ++k, g0 = 1LL * g0 * gn % P) {
-                int x = a[k], y = 1LL * g0 * a[k + i / 2] % P;
-                a[k] = (x + y) % P;
-                a[k + i / 2] = (x - y + P) % P;
-            }
+    auto [ptr, ec] = from_chars(num.data(), num.data() + num.size(), *this);
+    assert(ec == std::errc() && ptr == num.data() + num.size());
+}
+template <size_t Limbs>
+std::from_chars_result from_chars(const char *first, const char *last, fixed_big_uint<Limbs> &value) {
+    size_t n = Decimal::digits(first, last), z = 0;
+    if (n == 0)
+        return {first, std::errc::invalid_argument};
+    // 跳过前导零后仍超过 Limbs 位时与 std::from_chars 相同：返回 result_out_of_range，value 不变
+    while (z + 1 < n && first[z] == '0')
+        z++;
+    if ((n - z + 3) / 4 > Limbs)
+        return {first + n, std::errc::result_out_of_range};
+    value.len = Decimal::parse(first + z, n - z, value.data.data());
+    return {first + n, std::errc()};
+}
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR int fixed_big_uint<Limbs>::compareAbs(const fixed_big_uint &a, const fixed_big_uint &b) {
+    if (a.len != b.len)
+        return a.len < b.len ? -1 : 1;
+    for (size_t i = a.len; i-- > 0;)
+        if (a.data[i] != b.data[i])
+            return a.data[i] < b.data[i] ? -1 : 1;
+    return 0;
+}
+// 编译期用的朴素乘法，c[0, al + bl) = a * b，c 可以是 a 或 b
+template <size_t Limbs>
+BIGINT_STATIC_CONSTEXPR void fixed_big_uint<Limbs>::multiplyBasecase(const value_type a[], size_t al,
+                                                                     const value_type b[], size_t bl,
+                                                                     value_type c[]) {
+    std::array<value_type, Limbs + 1> t{};
+    for (size_t i = 0; i < al; i++) {
+        long long carry = 0;
+        for (size_t j = 0; j < bl; j++) {
+            long long x = t[i + j] + (long long)a[i] * b[j] + carry;
+            t[i + j] = x % BIT_LIMIT;
+            carry = x / BIT_LIMIT;
         }
+        if (bl)
+            t[i + bl] = carry;
     }
-    if (inv == -1) {
-        int n_inv = big_uint::inv(n, P);
-        for (int i = 0; i < n; i++)
-            a[i] = 1LL * a[i] * n_inv % P;
+    std::copy(t.begin(), t.begin() + al + bl, c);
+}
+// 运行时的乘法，c[0, al + bl) = a * b，c 可以是 a 或 b；al + bl 不超过 Limbs + 1
+template <size_t Limbs>
+void fixed_big_uint<Limbs>::multiplyRuntime(const value_type a[], size_t al, const value_type b[], size_t bl,
+                                            value_type c[]) {
+    if constexpr (Limbs <= BIGINT_STATIC_STACK_LIMBS) {
+        std::array<long long, ::Multiply::multiply_scratch_size(Limbs + 1, 0)> buffer;
+        ::Multiply::Scratch s{buffer.data(), buffer.data() + buffer.size()};
+        ::Multiply::multiply(a, al, b, bl, c, s);
+    } else {
+        ::Multiply::multiply(a, al, b, bl, c);
     }
 }
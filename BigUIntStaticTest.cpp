@@ -0,0 +1,11 @@
+#include "BigUIntStatic.h"
+#include "test.h"
+
+#include <iostream>
+
+int main() {
+    test<big_uint>();
+    edgetest<big_uint>();
+    statictest<big_uint>();
+    return 0;
+}
@@ -1,173 +1,287 @@
+#include "Multiply.h"
+#include "Divide.h"
+#include "Decimal.h"
+#include "Scalar.h"
+#include "Memory.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-const size_t pow10[19] = {1, 10, 100, 1000, 10000};
-const size_t BIT_SIZE = 4;
-const size_t BIT_LIMIT = pow10[BIT_SIZE];
-const int P = 998244353;
+// 对象内直接存放的位数，位数更多时才分配堆空间
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 4
+#endif
 
-class big_uint {
+// Base = 10^BIT_SIZE 进制的无符号大整数，每位用 Limb 存储
+// 例如 basic_big_uint<uint32_t, 1000000000> 用 64 位乘积，basic_big_uint<uint64_t, 10^18> 用 128 位乘积
+template <class Limb, Limb Base> class basic_big_uint {
   public:
-    using value_type = int;
+    using value_type = Limb;
+    static constexpr size_t BIT_SIZE = Decimal::exponent(Base);
+    static constexpr Limb BIT_LIMIT = Base;
+    static constexpr size_t INLINE_LIMBS = BIGINT_INLINE_LIMBS;
+    static_assert(BIT_SIZE > 0, "Base 应为 10 的幂");
+    static_assert(Base - 1 <= std::numeric_limits<Limb>::max() - Base, "Limb 应能容纳 2 * Base");
+    static_assert(INLINE_LIMBS > 0, "BIGINT_INLINE_LIMBS 至少为 1");
 
     // 构造函数
-    big_uint();
-    big_uint(const big_uint &t);
-    big_uint(big_uint &&t);
-    big_uint(value_type num);
-    big_uint(const std::string &num);
+    basic_big_uint();
+    basic_big_uint(const basic_big_uint &t);
+    basic_big_uint(basic_big_uint &&t);
+    basic_big_uint(value_type num);
+    basic_big_uint(std::string_view num);
+    // std::string 需单独重载才能写 basic_big_uint b = s；写成模板，字面量不会匹配它
+    template <class Alloc> basic_big_uint(const std::basic_string<char, std::char_traits<char>, Alloc> &num);
+    basic_big_uint(const char *num, size_t n);
 
     // 析构函数
-    ~big_uint();
+    ~basic_big_uint();
 
     // 赋值操作符
-    big_uint &operator=(const big_uint &t);
-    big_uint &operator=(big_uint &&t);
-    big_uint &operator=(value_type num);
-    big_uint &operator=(const std::string &num);
+    basic_big_uint &operator=(const basic_big_uint &t);
+    basic_big_uint &operator=(basic_big_uint &&t);
+    basic_big_uint &operator=(value_type num);
+    basic_big_uint &operator=(std::string_view num);
+    template <class Alloc>
+    basic_big_uint &operator=(const std::basic_string<char, std::char_traits<char>, Alloc> &num);
 
     // 输入输出
-    friend std::ostream &operator<<(std::ostream &os, const big_uint &t);
+    template <class L, L B> friend std::ostream &operator<<(std::ostream &os, const basic_big_uint<L, B> &t);
+    std::string to_string() const;
+    std::to_chars_result to_chars(char *first, char *last) const;
+    template <class L, L B>
+    friend std::from_chars_result from_chars(const char *first, const char *last, basic_big_uint<L, B> &value);
 
-    // 算术运算
-    big_uint &operator+=(const big_uint &t);
-    friend big_uint operator+(const big_uint &a, const big_uint &b);
-    big_uint &operator-=(const big_uint &t);
-    friend big_uint operator-(const big_uint &a, const big_uint &b);
-    big_uint &operator*=(const big_uint &t);
-    friend big_uint operator*(const big_uint &a, const big_uint &b);
-    std::string estimation(size_t sz);
+    // 算术运算，与比较运算一样定义在类内，两边都可以隐式转换
+    basic_big_uint &operator+=(const basic_big_uint &t);
+    basic_big_uint &operator-=(const basic_big_uint &t);
+    basic_big_uint &operator*=(const basic_big_uint &t);
+    basic_big_uint &operator/=(const basic_big_uint &t);
+    basic_big_uint &operator%=(const basic_big_uint &t);
+    friend basic_big_uint operator+(const basic_big_uint &a, const basic_big_uint &b) {
+        return basic_big_uint(a) + b;
+    }
+    friend basic_big_uint operator-(const basic_big_uint &a, const basic_big_uint &b) {
+        return basic_big_uint(a) - b;
+    }
+    // 乘积直接写入新对象，不复制 a
+    friend basic_big_uint operator*(const basic_big_uint &a, const basic_big_uint &b) {
+        basic_big_uint c;
+        mul(c, a, b);
+        return c;
+    }
+    friend basic_big_uint operator/(const basic_big_uint &a, const basic_big_uint &b) {
+        return divmod(a, b).first;
+    }
+    friend basic_big_uint operator%(const basic_big_uint &a, const basic_big_uint &b) {
+        return divmod(a, b).second;
+    }
+    template <class L, L B>
+    friend std::pair<basic_big_uint<L, B>, basic_big_uint<L, B>> divmod(const basic_big_uint<L, B> &a,
+                                                                       const basic_big_uint<L, B> &b);
+    // 与单个机器字的运算，x 不能为负
+    basic_big_uint &operator+=(int64_t x);
+    basic_big_uint &operator-=(int64_t x);
+    basic_big_uint &operator*=(int64_t x);
+    basic_big_uint &operator/=(int64_t x);
+    basic_big_uint &operator%=(int64_t x);
+    template <class L, L B> friend int64_t operator%(const basic_big_uint<L, B> &a, int64_t x);
+    // 右值版本，结果写在临时对象的空间上
+    template <class L, L B>
+    friend basic_big_uint<L, B> operator+(basic_big_uint<L, B> &&a, basic_big_uint<L, B> &&b);
+    template <class L, L B>
+    friend basic_big_uint<L, B> operator-(const basic_big_uint<L, B> &a, basic_big_uint<L, B> &&b);
+    template <class L, L B>
+    friend basic_big_uint<L, B> operator*(basic_big_uint<L, B> &&a, basic_big_uint<L, B> &&b);
+    basic_big_uint &square();
+    // dst = a * b，dst 可以与 a 或 b 相同；乘法的临时空间从 ws 中取用，不指定时用本线程的工作区
+    template <class L, L B>
+    friend void mul(basic_big_uint<L, B> &dst, const basic_big_uint<L, B> &a, const basic_big_uint<L, B> &b,
+                    Memory::Workspace &ws);
+    template <class L, L B>
+    friend void mul(basic_big_uint<L, B> &dst, const basic_big_uint<L, B> &a, const basic_big_uint<L, B> &b);
+    void shrink_to_fit();
+    std::string estimation(size_t sz = 6);
 
-    // 比较运算
-    friend bool operator==(const big_uint &a, const big_uint &b);
-    friend bool operator!=(const big_uint &a, const big_uint &b);
-    friend bool operator<(const big_uint &a, const big_uint &b);
-    friend bool operator<=(const big_uint &a, const big_uint &b);
+    // 比较运算，定义在类内且不是模板，另一边可以是能隐式转换的整数或字符串，如 a == 5、3 < a
+    friend bool operator==(const basic_big_uint &a, const basic_big_uint &b) { return compareAbs(a, b) == 0; }
+    friend bool operator!=(const basic_big_uint &a, const basic_big_uint &b) { return !(a == b); }
+    friend bool operator<(const basic_big_uint &a, const basic_big_uint &b) { return compareAbs(a, b) < 0; }
+    friend bool operator<=(const basic_big_uint &a, const basic_big_uint &b) { return compareAbs(a, b) <= 0; }
 
   private:
     // 内部辅助函数
-    void copyByString(const std::string &num);
-    static int sgn(value_type x);
-    static int compareAbs(const big_uint &a, const big_uint &b);
+    void copyByString(std::string_view num);
+    static int compareAbs(const basic_big_uint &a, const basic_big_uint &b);
     static void plus(value_type a[], value_type b[], size_t al, size_t bl);
     static void minus(value_type a[], value_type b[], size_t al, size_t bl);
-    static void multiply(value_type a[], value_type b[], size_t al, size_t bl, bool ntt);
-    static void NTT(value_type a[], size_t n, int inv);
-    static int ksm(int a, int b, int P);
-    static int inv(int a, int P);
+    static void minusFrom(value_type a[], value_type b[], size_t bl);
 
     void resize(size_t new_capacity);
+    void release();
+    void assign(const value_type p[], size_t n);
+    void append(uint64_t c);
 
     // 成员变量
     size_t len = 0;
-    size_t capacity = 4; // 默认容量为4
-    value_type *data = nullptr;
+    size_t capacity = INLINE_LIMBS;
+    value_type *data = local;
+    value_type local[INLINE_LIMBS] = {}; // 不超过 INLINE_LIMBS 位时直接存放在对象内，不分配内存
 };
+using big_uint = basic_big_uint<int, 10000>;
+
 // 构造函数
-big_uint::big_uint() : data(new value_type[capacity]{0}) {}
+template <class Limb, Limb Base> basic_big_uint<Limb, Base>::basic_big_uint() {}
 
-big_uint::big_uint(const big_uint &t)
-    : len(t.len), capacity(t.capacity), data(new value_type[t.capacity]{0}) {
-    std::copy(t.data, t.data + t.len, data);
+template <class Limb, Limb Base> basic_big_uint<Limb, Base>::basic_big_uint(const basic_big_uint &t) {
+    assign(t.data, t.len);
 }
 
-big_uint::big_uint(big_uint &&t) : len(t.len), capacity(t.capacity), data(t.data) {
-    t.len = 0;
-    t.capacity = 0;
-    t.data = nullptr;
-}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base>::basic_big_uint(basic_big_uint &&t) { *this = std::move(t); }
 
-big_uint::big_uint(value_type num) : data(new value_type[capacity]{0}) {
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
-        if (len == capacity) {
-            resize(capacity * 2);
-        }
-    }
-}
+template <class Limb, Limb Base> basic_big_uint<Limb, Base>::basic_big_uint(value_type num) { append(num); }
 
-big_uint::big_uint(const std::string &num) : data(new value_type[capacity]{0}) {
-    copyByString(num);
-}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base>::basic_big_uint(std::string_view num) { copyByString(num); }
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base>::basic_big_uint(const char *num, size_t n) : basic_big_uint(std::string_view(num, n)) {}
+template <class Limb, Limb Base>
+template <class Alloc>
+basic_big_uint<Limb, Base>::basic_big_uint(const std::basic_string<char, std::char_traits<char>, Alloc> &num)
+    : basic_big_uint(std::string_view(num)) {}
 
 // 析构函数
-big_uint::~big_uint() { delete[] data; }
+template <class Limb, Limb Base> basic_big_uint<Limb, Base>::~basic_big_uint() {
+    if (data != local)
+        Memory::deallocate(data, capacity);
+}
 
-void big_uint::resize(size_t new_capacity) {
+// 容量不足 new_capacity 时换到堆上更大的空间，新空间只清零 len 之后的部分，离开 local 时把它清零
+template <class Limb, Limb Base> void basic_big_uint<Limb, Base>::resize(size_t new_capacity) {
     if (new_capacity <= capacity)
         return;
-    value_type *new_data = new value_type[new_capacity]{0};
-    std::copy(data, data + len, new_data);
-    delete[] data;
+    value_type *new_data = Memory::allocate<value_type>(new_capacity);
+    std::fill(std::copy(data, data + len, new_data), new_data + new_capacity, 0);
+    if (data == local)
+        std::fill(local, local + INLINE_LIMBS, 0);
+    else
+        Memory::deallocate(data, capacity);
     data = new_data;
     capacity = new_capacity;
 }
-// 赋值运算符
-big_uint &big_uint::operator=(const big_uint &t) {
+// 释放堆上的空间，回到值为 0 的内联状态
+template <class Limb, Limb Base> void basic_big_uint<Limb, Base>::release() {
+    if (data != local)
+        Memory::deallocate(data, capacity);
+    std::fill(local, local + INLINE_LIMBS, 0);
+    data = local;
+    capacity = INLINE_LIMBS;
+    len = 0;
+}
+// 把值设为 p[0, n)，需要换空间时直接申请恰好 n 位且不清零
+template <class Limb, Limb Base> void basic_big_uint<Limb, Base>::assign(const value_type p[], size_t n) {
+    if (n > capacity) {
+        value_type *new_data = Memory::allocate<value_type>(n);
+        if (data == local)
+            std::fill(local, local + INLINE_LIMBS, 0);
+        else
+            Memory::deallocate(data, capacity);
+        data = new_data;
+        capacity = n;
+    } else if (n < len)
+        std::fill(data + n, data + len, 0);
+    std::copy(p, p + n, data);
+    len = n;
+}
+// 把 c 按进制拆开接在最高位之后
+template <class Limb, Limb Base> void basic_big_uint<Limb, Base>::append(uint64_t c) {
+    for (; c; c /= Base) {
+        if (len == capacity)
+            resize(capacity * 2);
+        data[len++] = value_type(c % Base);
+    }
+}
+// 赋值运算符，空间足够时不重新分配
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator=(const basic_big_uint &t) {
     if (this == &t)
         return *this;
-    delete[] data;
-    len = t.len;
-    capacity = t.capacity;
-    data = new value_type[capacity]{0};
-    std::copy(t.data, t.data + t.len, data);
+    assign(t.data, t.len);
     return *this;
 }
 
-big_uint &big_uint::operator=(big_uint &&t) {
+// t 在堆上时直接接管它的空间，否则只复制 local 中的几位
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator=(basic_big_uint &&t) {
     if (this == &t)
         return *this;
-    delete[] data;
-    len = t.len;
-    capacity = t.capacity;
-    data = t.data;
-    t.len = 0;
-    t.capacity = 0;
-    t.data = nullptr;
+    if (t.data == t.local) {
+        std::fill(data, data + len, 0);
+        std::copy(t.local, t.local + t.len, data);
+        len = t.len;
+        t.release();
+    } else {
+        release();
+        len = t.len;
+        capacity = t.capacity;
+        data = t.data;
+        t.len = 0;
+        t.capacity = INLINE_LIMBS;
+        t.data = t.local;
+    }
     return *this;
 }
 
-big_uint &big_uint::operator=(value_type num) {
-    delete[] data;
-    capacity = 4;
-    data = new value_type[capacity]{0};
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator=(value_type num) {
+    std::fill(data, data + len, 0);
     len = 0;
-    while (num) {
-        data[len++] = num % BIT_LIMIT;
-        num /= BIT_LIMIT;
-        if (len == capacity) {
-            resize(capacity * 2);
-        }
-    }
+    append(num);
     return *this;
 }
 
-big_uint &big_uint::operator=(const std::string &num) {
-    delete[] data;
-    capacity = 4;
-    data = new value_type[capacity]{0};
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator=(std::string_view num) {
     copyByString(num);
     return *this;
 }
+template <class Limb, Limb Base>
+template <class Alloc>
+basic_big_uint<Limb, Base> &
+basic_big_uint<Limb, Base>::operator=(const std::basic_string<char, std::char_traits<char>, Alloc> &num) {
+    return *this = std::string_view(num);
+}
 // 输出
-std::ostream &operator<<(std::ostream &os, const big_uint &t) {
-    if (t.len == 0)
-        return os << 0;
-    for (int i = t.len - 1; i >= 0; i--)
-        os << t.data[i];
-    return os;
+template <class Limb, Limb Base> std::string basic_big_uint<Limb, Base>::to_string() const {
+    std::string s(Decimal::length<BIT_SIZE>(data, len), '0');
+    Decimal::to_chars<BIT_SIZE>(&s[0], &s[0] + s.size(), data, len);
+    return s;
+}
+template <class Limb, Limb Base>
+std::to_chars_result basic_big_uint<Limb, Base>::to_chars(char *first, char *last) const {
+    return Decimal::to_chars<BIT_SIZE>(first, last, data, len);
+}
+template <class Limb, Limb Base>
+std::ostream &operator<<(std::ostream &os, const basic_big_uint<Limb, Base> &t) {
+    std::string s = t.to_string();
+    return os.write(s.data(), s.size());
 }
 // 算术运算
-big_uint &big_uint::operator+=(const big_uint &t) {
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator+=(const basic_big_uint &t) {
+    resize(std::max(len, t.len) + 1);
     len = std::max(len, t.len);
-    resize(len + 1);
     plus(data, t.data, len, t.len);
     len++;
     while (len && !data[len - 1])
@@ -175,7 +289,8 @@ big_uint &big_uint::operator+=(const big_uint &t) {
     return *this;
 }
 
-big_uint &big_uint::operator-=(const big_uint &t) {
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator-=(const basic_big_uint &t) {
     assert(t <= *this);
     resize(len);
     minus(data, t.data, len, t.len);
@@ -184,18 +299,197 @@ big_uint &big_uint::operator-=(const big_uint &t) {
     return *this;
 }
 
-big_uint &big_uint::operator*=(const big_uint &t) {
-    resize((len + t.len) * 4);
-    big_uint::multiply(data, t.data, len, t.len, len + t.len > 128);
-    len += t.len;
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator*=(const basic_big_uint &t) {
+    mul(*this, *this, t);
+    return *this;
+}
+// 右值版本，结果写在临时对象的空间上，两边都是临时对象时用容量大的一个
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator+(basic_big_uint<Limb, Base> &&a, const basic_big_uint<Limb, Base> &b) {
+    return std::move(a += b);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator+(const basic_big_uint<Limb, Base> &a, basic_big_uint<Limb, Base> &&b) {
+    return std::move(b += a);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator+(basic_big_uint<Limb, Base> &&a, basic_big_uint<Limb, Base> &&b) {
+    return a.capacity >= b.capacity ? std::move(a += b) : std::move(b += a);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator-(basic_big_uint<Limb, Base> &&a, const basic_big_uint<Limb, Base> &b) {
+    return std::move(a -= b);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator-(const basic_big_uint<Limb, Base> &a, basic_big_uint<Limb, Base> &&b) {
+    assert(b <= a);
+    b.resize(a.len);
+    basic_big_uint<Limb, Base>::minusFrom(b.data, a.data, a.len);
+    b.len = a.len;
+    while (b.len && !b.data[b.len - 1])
+        b.len--;
+    return std::move(b);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator-(basic_big_uint<Limb, Base> &&a, basic_big_uint<Limb, Base> &&b) {
+    return std::move(a -= b);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator*(basic_big_uint<Limb, Base> &&a, const basic_big_uint<Limb, Base> &b) {
+    return std::move(a *= b);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator*(const basic_big_uint<Limb, Base> &a, basic_big_uint<Limb, Base> &&b) {
+    return std::move(b *= a);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator*(basic_big_uint<Limb, Base> &&a, basic_big_uint<Limb, Base> &&b) {
+    return a.capacity >= b.capacity ? std::move(a *= b) : std::move(b *= a);
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator+(basic_big_uint<Limb, Base> &&a, int64_t x) { return std::move(a += x); }
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator+(int64_t x, basic_big_uint<Limb, Base> &&a) { return std::move(a += x); }
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator-(basic_big_uint<Limb, Base> &&a, int64_t x) { return std::move(a -= x); }
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator*(basic_big_uint<Limb, Base> &&a, int64_t x) { return std::move(a *= x); }
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator*(int64_t x, basic_big_uint<Limb, Base> &&a) { return std::move(a *= x); }
+// 除法，返回商和余数，除数不能为 0
+template <class Limb, Limb Base>
+std::pair<basic_big_uint<Limb, Base>, basic_big_uint<Limb, Base>> divmod(const basic_big_uint<Limb, Base> &a,
+                                                                         const basic_big_uint<Limb, Base> &b) {
+    assert(b.len);
+    if (basic_big_uint<Limb, Base>::compareAbs(a, b) < 0)
+        return {basic_big_uint<Limb, Base>(), a};
+    basic_big_uint<Limb, Base> q, r;
+    q.resize(a.len - b.len + 1);
+    r.resize(b.len);
+    ::Divide::divide<Limb, Base>(a.data, a.len, b.data, b.len, q.data, r.data);
+    q.len = a.len - b.len + 1;
+    r.len = b.len;
+    while (q.len && !q.data[q.len - 1])
+        q.len--;
+    while (r.len && !r.data[r.len - 1])
+        r.len--;
+    return {std::move(q), std::move(r)};
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator/=(const basic_big_uint &t) {
+    return *this = divmod(*this, t).first;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator%=(const basic_big_uint &t) {
+    return *this = divmod(*this, t).second;
+}
+// 与单个机器字的运算，一趟完成，除了最高位的进位外不分配内存
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator+=(int64_t x) {
+    assert(x >= 0);
+    append(::Scalar::add_1<Limb, Base>(data, len, x));
+    return *this;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator-=(int64_t x) {
+    assert(x >= 0 && (::Scalar::cmp_1<Limb, Base>(data, len, x) >= 0));
+    ::Scalar::sub_1<Limb, Base>(data, len, x);
     while (len && !data[len - 1])
         len--;
     return *this;
 }
-big_uint operator+(const big_uint &a, const big_uint &b) { return big_uint(a) += b; }
-big_uint operator-(const big_uint &a, const big_uint &b) { return big_uint(a) -= b; }
-big_uint operator*(const big_uint &a, const big_uint &b) { return big_uint(a) *= b; }
-std::string big_uint::estimation(size_t sz = 6) {
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator*=(int64_t x) {
+    assert(x >= 0);
+    append(::Scalar::mul_1<Limb, Base>(data, len, x));
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator/=(int64_t x) {
+    assert(x > 0);
+    ::Scalar::div_1<Limb, Base>(data, len, x);
+    while (len && !data[len - 1])
+        len--;
+    return *this;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::operator%=(int64_t x) {
+    assert(x > 0);
+    uint64_t r = ::Scalar::mod_1<Limb, Base>(data, len, x);
+    std::fill(data, data + len, 0);
+    len = 0;
+    append(r);
+    return *this;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator+(const basic_big_uint<Limb, Base> &a, int64_t x) {
+    return basic_big_uint<Limb, Base>(a) + x;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator+(int64_t x, const basic_big_uint<Limb, Base> &a) {
+    return basic_big_uint<Limb, Base>(a) + x;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator-(const basic_big_uint<Limb, Base> &a, int64_t x) {
+    return basic_big_uint<Limb, Base>(a) - x;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator*(const basic_big_uint<Limb, Base> &a, int64_t x) {
+    return basic_big_uint<Limb, Base>(a) * x;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator*(int64_t x, const basic_big_uint<Limb, Base> &a) {
+    return basic_big_uint<Limb, Base>(a) * x;
+}
+template <class Limb, Limb Base>
+basic_big_uint<Limb, Base> operator/(const basic_big_uint<Limb, Base> &a, int64_t x) {
+    return std::move(basic_big_uint<Limb, Base>(a) /= x);
+}
+template <class Limb, Limb Base> int64_t operator%(const basic_big_uint<Limb, Base> &a, int64_t x) {
+    assert(x > 0);
+    return ::Scalar::mod_1<Limb, Base>(a.data, a.len, x);
+}
+template <class Limb, Limb Base> basic_big_uint<Limb, Base> &basic_big_uint<Limb, Base>::square() {
+    mul(*this, *this, *this);
+    return *this;
+}
+template <class Limb, Limb Base>
+void mul(basic_big_uint<Limb, Base> &dst, const basic_big_uint<Limb, Base> &a, const basic_big_uint<Limb, Base> &b,
+         Memory::Workspace &ws) {
+    size_t n = a.len + b.len;
+    // 结果直接写入 dst，dst 不是乘数时不必保留原来的值
+    if (&dst != &a && &dst != &b) {
+        std::fill(dst.data, dst.data + dst.len, 0);
+        dst.len = 0;
+    }
+    // 多留一位给随后加法的进位
+    dst.resize(n + 1);
+    ::Multiply::multiply<Limb, Base>(a.data, a.len, b.data, b.len, dst.data, ws);
+    dst.len = n;
+    while (dst.len && !dst.data[dst.len - 1])
+        dst.len--;
+}
+template <class Limb, Limb Base>
+void mul(basic_big_uint<Limb, Base> &dst, const basic_big_uint<Limb, Base> &a, const basic_big_uint<Limb, Base> &b) {
+    mul(dst, a, b, Memory::workspace());
+}
+// 容量缩到恰好 len 位，不超过 INLINE_LIMBS 位时回到对象内
+template <class Limb, Limb Base> void basic_big_uint<Limb, Base>::shrink_to_fit() {
+    if (data == local || capacity == len)
+        return;
+    value_type *old = data;
+    size_t old_capacity = capacity;
+    if (len <= INLINE_LIMBS)
+        data = local, capacity = INLINE_LIMBS;
+    else
+        data = Memory::allocate<value_type>(len), capacity = len;
+    std::copy(old, old + len, data);
+    Memory::deallocate(old, old_capacity);
+}
+template <class Limb, Limb Base> std::string basic_big_uint<Limb, Base>::estimation(size_t sz) {
     if (len == 0)
         return "0";
     std::string s = std::to_string(data[len - 1]);
@@ -208,47 +502,56 @@ std::string big_uint::estimation(size_t sz = 6) {
     s.insert(1, ".");
     return s + "e" + std::to_string(exponent - 1);
 }
-big_uint pow(big_uint a, long long b) {
-    big_uint res(1);
-    for (; b; a *= a, b >>= 1) {
+// 先把 a 平方到 b 的最低一位 1，结果从 a 的副本开始，b 为 2 的幂时直接把 a 移出去
+template <class Limb, Limb Base> basic_big_uint<Limb, Base> pow(basic_big_uint<Limb, Base> a, long long b) {
+    if (b == 0)
+        return basic_big_uint<Limb, Base>(1);
+    for (; !(b & 1); b >>= 1)
+        a.square();
+    if (b == 1)
+        return a;
+    basic_big_uint<Limb, Base> res = a;
+    while (b >>= 1) {
+        a.square();
         if (b & 1)
             res *= a;
     }
     return res;
 }
 // 比较运算
-bool operator==(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) == 0; }
-bool operator!=(const big_uint &a, const big_uint &b) { return !(a == b); }
-bool operator<(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) < 0; }
-bool operator<=(const big_uint &a, const big_uint &b) { return big_uint::compareAbs(a, b) <= 0; }
 // 辅助函数
-void big_uint::copyByString(const std::string &num) {
-    if (num.front() == '0' && num.size() == 1) {
-        len = 0;
-    } else {
-        assert(num[0] != '-');
-        size_t n = num.size();
-        len = (n - 1) / BIT_SIZE + 1;
-        resize(len);
-        for (size_t i = 0, j = num.size() - 1; i < n; i++, j--) {
-            assert(num[j] >= '0' && num[j] <= '9');
-            data[i / BIT_SIZE] += (num[j] - '0') * pow10[i % BIT_SIZE];
-        }
-    }
+template <class Limb, Limb Base> void basic_big_uint<Limb, Base>::copyByString(std::string_view num) {
+    auto [ptr, ec] = from_chars(num.data(), num.data() + num.size(), *this);
+    assert(ec == std::errc() && ptr == num.data() + num.size());
 }
-int big_uint::sgn(value_type x) { return (x > 0) - (x < 0); }
-int big_uint::compareAbs(const big_uint &a, const big_uint &b) {
-    if (a.len == b.len) {
-        for (int i = a.len - 1; i >= 0; i--)
-            if (a.data[i] != b.data[i])
-                return sgn(a.data[i] - b.data[i]);
-        return 0;
-    } else {
-        return sgn(a.len - b.len);
-    }
+template <class Limb, Limb Base>
+std::from_chars_result from_chars(const char *first, const char *last, basic_big_uint<Limb, Base> &value) {
+    constexpr size_t K = basic_big_uint<Limb, Base>::BIT_SIZE;
+    size_t n = Decimal::digits(first, last);
+    if (n == 0)
+        return {first, std::errc::invalid_argument};
+    size_t old = value.len, l = (n + K - 1) / K;
+    value.len = 0;
+    value.resize(l);
+    value.len = Decimal::parse<K>(first, n, value.data);
+    // 原来更长时把多出的部分清零
+    std::fill(value.data + l, value.data + std::max(l, old), 0);
+    return {first + n, std::errc()};
+}
+// 位数不同时位数多的大；Limb 可能是无符号类型，逐位比较时不做减法
+template <class Limb, Limb Base>
+int basic_big_uint<Limb, Base>::compareAbs(const basic_big_uint &a, const basic_big_uint &b) {
+    if (a.len != b.len)
+        return a.len < b.len ? -1 : 1;
+    for (size_t i = a.len; i-- > 0;)
+        if (a.data[i] != b.data[i])
+            return a.data[i] < b.data[i] ? -1 : 1;
+    return 0;
 }
-void big_uint::plus(value_type a[], value_type b[], size_t al, size_t bl) {
-    for (int i = 0; i < al; i++) {
+template <class Limb, Limb Base>
+void basic_big_uint<Limb, Base>::plus(value_type a[], value_type b[], size_t al, size_t bl) {
+    BIG_STATS_SCOPE(big_stats::add, al);
+    for (size_t i = 0; i < al; i++) {
         if (i < bl)
             a[i] += b[i];
         if (a[i] >= BIT_LIMIT) {
@@ -257,73 +560,25 @@ void big_uint::plus(value_type a[], value_type b[], size_t al, size_t bl) {
         }
     }
 }
-void big_uint::minus(value_type a[], value_type b[], size_t al, size_t bl) {
-    for (int i = 0; i < al; i++) {
-        if (i < bl)
-            a[i] -= b[i];
-        if (a[i] < 0) {
-            a[i + 1]--;
-            a[i] += BIT_LIMIT;
-        }
-    }
-}
-void big_uint::multiply(value_type a[], value_type b[], size_t al, size_t bl, bool ntt) {
-    if (ntt) {
-        size_t len = 2 << std::__lg(al + bl - 1);
-        value_type *t = new value_type[len];
-        std::copy(b, b + bl, t);
-        NTT(a, len, 1);
-        NTT(t, len, 1);
-        for (int i = 0; i < len; i++)
-            a[i] = 1LL * a[i] * b[i] % P;
-        NTT(a, len, -1);
-        delete[] t;
-    } else {
-        if (al == 0 || bl == 0) {
-            std::fill(a, a + al, 0);
-            return;
-        }
-        for (int k = al + bl - 2; k >= 0; k--) {
-            value_type tmp = 0;
-            for (int i = std::min(k, (int)al - 1); i >= 0 && k - i < bl; i--)
-                tmp += a[i] * b[k - i];
-            a[k] = tmp;
-        }
-    }
-    for (int i = 0; i < al + bl; i++) {
-        a[i + 1] += a[i] / BIT_LIMIT;
-        a[i] %= BIT_LIMIT;
+// 借位单独记录，a[i] 不会出现负数
+template <class Limb, Limb Base>
+void basic_big_uint<Limb, Base>::minus(value_type a[], value_type b[], size_t al, size_t bl) {
+    BIG_STATS_SCOPE(big_stats::sub, al);
+    value_type borrow = 0;
+    for (size_t i = 0; i < al; i++) {
+        value_type x = (i < bl ? b[i] : 0) + borrow;
+        borrow = a[i] < x;
+        a[i] = a[i] + (borrow ? BIT_LIMIT : 0) - x;
     }
 }
-int big_uint::ksm(int a, int b, int P) {
-    int s = 1;
-    for (; b; b >>= 1, a = 1LL * a * a % P)
-        if (b & 1)
-            s = 1LL * s * a % P;
-    return s;
-}
-int big_uint::inv(int a, int P) { return big_uint::ksm(a, P - 2, P); }
-void big_uint::NTT(value_type a[], size_t n, int inv) {
-    std::vector<size_t> rev(n);
-    for (size_t i = 0; i < n; i++) {
-        rev[i] = (rev[i >> 1] >> 1) | ((i & 1) << std::__lg(n >> 1));
-        if (i < rev[i])
-            std::swap(a[i], a[rev[i]]);
-    }
-    for (size_t i = 2; i <= n; i <<= 1) {
-        int gn = ksm(inv == 1 ? 3 : big_uint::inv(3, P), (P - 1) / i, P);
-        for (size_t j = 0; j < n; j += i) {
-            int g0 = 1;
-            for (size_t k = j; k < j + i / 2; ++k, g0 = 1LL * g0 * gn % P) {
-                int x = a[k], y = 1LL * g0 * a[k + i / 2] % P;
-                a[k] = (x + y) % P;
-                a[k + i / 2] = (x - y + P) % P;
-            }
-        }
-    }
-    if (inv == -1) {
-        int n_inv = big_uint::inv(n, P);
-        for (int i = 0; i < n; i++)
-            a[i] = 1LL * a[i] * n_inv % P;
+// a[0, bl) = b[0, bl) - a[0, bl)，要求 b >= a
+template <class Limb, Limb Base>
+void basic_big_uint<Limb, Base>::minusFrom(value_type a[], value_type b[], size_t bl) {
+    BIG_STATS_SCOPE(big_stats::sub, bl);
+    value_type borrow = 0;
+    for (size_t i = 0; i < bl; i++) {
+        value_type x = a[i] + borrow;
+        borrow = b[i] < x;
+        a[i] = b[i] + (borrow ? BIT_LIMIT : 0) - x;
     }
 }
@@ -0,0 +1,19 @@
+#include "BigUIntStd.h"
+#include "test.h"
+
+#include <cstdint>
+#include <iostream>
+
+// 10^4 进制的 big_uint 以外，检查 32 位和 64 位数位的实例
+template <typename BigInt> void run() {
+    test<BigInt>();
+    edgetest<BigInt>();
+    randtest<BigInt>();
+}
+
+int main() {
+    run<big_uint>();
+    run<basic_big_uint<uint32_t, 1000000000>>();
+    run<basic_big_uint<uint64_t, 1000000000000000000>>();
+    return 0;
+}
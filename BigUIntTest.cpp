@@ -19,6 +19,7 @@ void task() {
 
 signed main() {
     task();
+    edgetest<big_uint>();
     randtest<big_uint>();
     return 0;
 }
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Stats.h"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+// 10^K 进制（默认 K = 4）小端数组与十进制字符串之间的转换
+namespace Decimal {
+// 0000 到 9999 的四位字符表
+struct Table {
+    char digits[10000][4];
+    Table() {
+        for (int i = 0; i < 10000; i++)
+            for (int j = 3, x = i; j >= 0; j--, x /= 10)
+                digits[i][j] = '0' + x % 10;
+    }
+};
+const Table &table() {
+    static const Table t;
+    return t;
+}
+
+// 10^k，k <= 19
+constexpr uint64_t power(size_t k) { return k ? power(k - 1) * 10 : 1; }
+// base = 10^k 时返回 k，否则返回 0
+constexpr size_t exponent(uint64_t base) {
+    size_t k = 0;
+    for (uint64_t x = 1; x < base && k < 19; x *= 10)
+        k++;
+    return power(k) == base ? k : 0;
+}
+
+// 10^K 进制的 data[0, len) 的十进制位数，0 算一位
+template <size_t K = 4, class Limb> size_t length(const Limb data[], size_t len) {
+    if (len == 0)
+        return 1;
+    size_t top = 1;
+    for (Limb x = data[len - 1]; x >= 10; x /= 10)
+        top++;
+    return (len - 1) * K + top;
+}
+
+// 把 x 写成 k 个字符（不足时补零），从右往左每次查表写四位
+template <class Limb> void put(char *p, Limb x, size_t k) {
+    const Table &t = table();
+    for (; k >= 4; k -= 4, x /= 10000)
+        std::memcpy(p + k - 4, t.digits[x % 10000], 4);
+    if (k)
+        std::memcpy(p, t.digits[x] + 4 - k, k);
+}
+
+// 把 10^K 进制的 data[0, len) 写入 [first, last)，空间不足时返回 errc::value_too_large
+// 最高位不补零，其余每位补足 K 个字符
+template <size_t K = 4, class Limb>
+std::to_chars_result to_chars(char *first, char *last, const Limb data[], size_t len) {
+    BIG_STATS_SCOPE(big_stats::print, len);
+    size_t n = length<K>(data, len);
+    if (size_t(last - first) < n)
+        return {last, std::errc::value_too_large};
+    if (len == 0) {
+        *first = '0';
+        return {first + 1, std::errc()};
+    }
+    const Table &t = table();
+    size_t top = n - (len - 1) * K;
+    put(first, data[len - 1], top);
+    char *p = first + top;
+    for (size_t i = len - 1; i-- > 0; p += K)
+        if constexpr (K == 4)
+            std::memcpy(p, t.digits[data[i]], 4);
+        else
+            put(p, data[i], K);
+    return {p, std::errc()};
+}
+
+// 按小端顺序读入 8 个字符
+uint64_t load8(const char *s) {
+    uint64_t x;
+    std::memcpy(&x, s, 8);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
+// 8 个字符是否都是数字：高半字节都是 3，且加 6 后高半字节仍是 3
+bool all_digits(uint64_t x) {
+    const uint64_t high = 0xF0F0F0F0F0F0F0F0ULL;
+    return ((x & high) | ((x + 0x0606060606060606ULL) & high) >> 4) == 0x3333333333333333ULL;
+}
+// [first, last) 开头连续的数字个数，每次检查 8 个字符
+size_t digits(const char *first, const char *last) {
+    const char *p = first;
+    while (last - p >= 8 && all_digits(load8(p)))
+        p += 8;
+    while (p < last && *p >= '0' && *p <= '9')
+        p++;
+    return p - first;
+}
+// 8 个数字字符转为两个 10^4 进制位，hi 为前四个字符，lo 为后四个字符
+// 先把相邻两个字符合成 0 到 99，再把相邻两组合成 0 到 9999，全程没有除法
+void parse8(const char *s, int &hi, int &lo) {
+    uint64_t x = load8(s) - 0x3030303030303030ULL;
+    x = (x * 10 + (x >> 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x * 100 + (x >> 16)) & 0x0000FFFF0000FFFFULL;
+    hi = int(x & 0xFFFF);
+    lo = int(x >> 32);
+}
+// 把 n 个数字字符 s[0, n) 按 10^K 进制写入 data[0, (n + K - 1) / K)，返回去掉前导零后的位数
+// 调用者需保证 s[0, n) 都是数字
+template <size_t K = 4, class Limb> size_t parse(const char *s, size_t n, Limb data[]) {
+    BIG_STATS_SCOPE(big_stats::parse, (n + K - 1) / K);
+    // k 个字符的值，按从左到右的顺序每次读 8 个
+    auto read = [](const char *p, size_t k) {
+        Limb x = 0;
+        for (; k >= 8; k -= 8, p += 8) {
+            int hi, lo;
+            parse8(p, hi, lo);
+            x = x * 100000000 + Limb(hi * 10000 + lo);
+        }
+        for (; k; k--, p++)
+            x = x * 10 + (*p - '0');
+        return x;
+    };
+    size_t len = (n + K - 1) / K, head = n - (len - 1) * K;
+    data[len - 1] = read(s, head);
+    const char *p = s + head;
+    size_t i = len - 1;
+    if constexpr (K == 4) {
+        for (; i >= 2; i -= 2, p += 8) {
+            int hi, lo;
+            parse8(p, hi, lo);
+            data[i - 1] = hi, data[i - 2] = lo;
+        }
+    }
+    for (; i >= 1; i--, p += K)
+        data[i - 1] = read(p, K);
+    while (len && !data[len - 1])
+        len--;
+    return len;
+}
+// 同 parse，但逐个字符读入、不查表，可以在常量表达式中使用
+template <size_t K = 4, class Limb> constexpr size_t parse_constexpr(const char *s, size_t n, Limb data[]) {
+    size_t len = (n + K - 1) / K;
+    for (size_t i = 0; i < len; i++) {
+        size_t last = n - i * K, first = last > K ? last - K : 0;
+        Limb x = 0;
+        for (size_t j = first; j < last; j++)
+            x = x * 10 + (s[j] - '0');
+        data[i] = x;
+    }
+    while (len && !data[len - 1])
+        len--;
+    return len;
+}
+
+// 把 10^P 进制的 a[0, n) 重新分组为 10^Q 进制写入 b，返回写入的位数（可能有前导零）
+// 超过 9 位的一位先拆成两半，中间值不超过 10^18
+template <size_t P, size_t Q, class From, class To> size_t regroup(const From a[], size_t n, To b[]) {
+    static_assert(P <= 18 && Q <= 9);
+    uint64_t acc = 0;
+    size_t d = 0, m = 0;
+    auto push = [&](uint64_t x, size_t k) {
+        acc += x * power(d);
+        for (d += k; d >= Q; d -= Q) {
+            b[m++] = To(acc % power(Q));
+            acc /= power(Q);
+        }
+    };
+    for (size_t i = 0; i < n; i++)
+        if constexpr (P <= 9)
+            push(a[i], P);
+        else
+            push(a[i] % power(P / 2), P / 2), push(a[i] / power(P / 2), P - P / 2);
+    if (d)
+        b[m++] = To(acc);
+    return m;
+}
+} // namespace Decimal
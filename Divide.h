@@ -0,0 +1,247 @@
+#pragma once
+
+#include "Multiply.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#ifndef DIVIDE_NEWTON_THRESHOLD
+#define DIVIDE_NEWTON_THRESHOLD 200
+#endif
+
+// 大整数除法：除数或商较短时用 Knuth 算法 D 逐位试商；否则用 Newton 迭代求出除数的倒数，
+// 再按 Barrett 约简每次求出一段商，耗时约为同规模乘法的常数倍
+namespace Divide {
+// 除数和商都不短于此值（Base 进制的位数）时使用 Newton 迭代
+size_t NEWTON_THRESHOLD = DIVIDE_NEWTON_THRESHOLD;
+
+// Base 进制（10^K 或 2^32）的小端数组上的除法，Limb 需能容纳 2 * Base - 1（2^32 进制时除外）
+template <class Limb, uint64_t Base> struct Divider {
+    using Wide = std::conditional_t<(Base <= (uint64_t(1) << 32)), uint64_t, unsigned __int128>;
+    using Vec = Memory::vector<Limb>;
+
+    // c[0, al + bl) = a * b
+    static void mul(const Limb a[], size_t al, const Limb b[], size_t bl, Limb c[]) {
+        if constexpr (Base == uint64_t(1) << 32)
+            Multiply::multiply(a, al, b, bl, c);
+        else
+            Multiply::multiply<Limb, Limb(Base)>(a, al, b, bl, c);
+    }
+    static size_t trim(const Limb a[], size_t n) {
+        while (n && !a[n - 1])
+            n--;
+        return n;
+    }
+    static int cmp(const Limb a[], size_t al, const Limb b[], size_t bl) {
+        al = trim(a, al), bl = trim(b, bl);
+        if (al != bl)
+            return al < bl ? -1 : 1;
+        for (size_t i = al; i-- > 0;)
+            if (a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+        return 0;
+    }
+    // a[0, al) += b[0, bl)，要求 al >= bl 且结果不超过 al 位
+    static void add(Limb a[], size_t al, const Limb b[], size_t bl) {
+        Wide c = 0;
+        for (size_t i = 0; i < al && (i < bl || c); i++) {
+            c += Wide(a[i]) + (i < bl ? b[i] : 0);
+            a[i] = Limb(c >= Base ? c - Base : c);
+            c = c >= Base;
+        }
+        assert(c == 0);
+    }
+    // a[0, al) -= b[0, bl)，要求 a >= b
+    static void sub(Limb a[], size_t al, const Limb b[], size_t bl) {
+        Wide c = 0;
+        for (size_t i = 0; i < al && (i < bl || c); i++) {
+            c += i < bl ? b[i] : 0;
+            bool borrow = Wide(a[i]) < c;
+            a[i] = Limb(Wide(a[i]) + (borrow ? Base : 0) - c);
+            c = borrow;
+        }
+        assert(c == 0);
+    }
+    // a[0, n) *= d，返回最高位的进位
+    static Limb mul_1(Limb a[], size_t n, Limb d) {
+        Wide c = 0;
+        for (size_t i = 0; i < n; i++) {
+            c += Wide(a[i]) * d;
+            a[i] = Limb(c % Base);
+            c /= Base;
+        }
+        return Limb(c);
+    }
+    // a[0, n) /= d，返回余数
+    static Limb div_1(Limb a[], size_t n, Limb d) {
+        Wide r = 0;
+        for (size_t i = n; i-- > 0;) {
+            r = r * Base + a[i];
+            a[i] = Limb(r / d);
+            r %= d;
+        }
+        return Limb(r);
+    }
+
+    // 算法 D：q[0, m - n + 1) = a / b，r[0, n) = a % b，要求 m >= n >= 2 且 b[n - 1] != 0
+    // 先把 a、b 同乘 d 使除数最高位不小于 Base / 2，试商至多偏大 2
+    static void knuth(const Limb a[], size_t m, const Limb b[], size_t n, Limb q[], Limb r[]) {
+        Limb d = Limb(Base / (Wide(b[n - 1]) + 1));
+        Vec u(a, a + m), v(b, b + n);
+        u.push_back(mul_1(u.data(), m, d));
+        mul_1(v.data(), n, d);
+        Wide vt = v[n - 1], vs = v[n - 2];
+        for (size_t j = m - n + 1; j-- > 0;) {
+            Wide num = Wide(u[j + n]) * Base + u[j + n - 1];
+            Wide qh = num / vt, rh = num % vt;
+            while (qh >= Base || qh * vs > rh * Base + u[j + n - 2]) {
+                qh--, rh += vt;
+                if (rh >= Base)
+                    break;
+            }
+            // u[j, j + n] -= qh * v，结果为负时说明试商偏大 1，加回一次 v
+            Wide carry = 0, borrow = 0;
+            for (size_t i = 0; i < n; i++) {
+                carry += qh * v[i];
+                Wide s = carry % Base + borrow;
+                carry /= Base;
+                borrow = Wide(u[i + j]) < s;
+                u[i + j] = Limb(Wide(u[i + j]) + (borrow ? Base : 0) - s);
+            }
+            if (Wide(u[j + n]) < carry + borrow) {
+                qh--;
+                Wide c = 0;
+                for (size_t i = 0; i < n; i++) {
+                    c += Wide(u[i + j]) + v[i];
+                    u[i + j] = Limb(c >= Base ? c - Base : c);
+                    c = c >= Base;
+                }
+            }
+            u[j + n] = 0;
+            q[j] = Limb(qh);
+        }
+        std::copy(u.begin(), u.begin() + n, r);
+        div_1(r, n, d);
+    }
+
+    // 约为 Base^(2n) / v 的 n + 1 位数，误差为很小的常数；要求 v[0, n) 的最高位不小于 Base / 2
+    // 用 v 的高 h = n / 2 + 2 位递归求出 y ≈ Base^(2h) / v_h，再做一步 Newton 迭代：
+    // x = y * Base^(n - h) + y * (Base^(n + h) - v * y) / Base^(2h)
+    static Vec reciprocal(const Limb v[], size_t n) {
+        if (n < std::max<size_t>(NEWTON_THRESHOLD, 8)) {
+            Vec a(n * 2 + 1), q(n + 2), r(n);
+            a[n * 2] = 1;
+            knuth(a.data(), a.size(), v, n, q.data(), r.data());
+            q.resize(n + 1);
+            return q;
+        }
+        size_t h = n / 2 + 2;
+        Vec y = reciprocal(v + n - h, h);
+        Vec p(n + h + 1), e(n + h + 1);
+        mul(v, n, y.data(), h + 1, p.data());
+        e[n + h] = 1;
+        bool negative = cmp(p.data(), p.size(), e.data(), e.size()) > 0;
+        if (negative)
+            sub(p.data(), p.size(), e.data(), e.size()), e.swap(p);
+        else
+            sub(e.data(), e.size(), p.data(), p.size());
+        size_t el = trim(e.data(), e.size());
+        Vec t(h + 1 + el), x(n + 2);
+        mul(y.data(), h + 1, e.data(), el, t.data());
+        std::copy(y.begin(), y.end(), x.begin() + (n - h));
+        if (t.size() > h * 2) {
+            if (negative)
+                sub(x.data(), x.size(), t.data() + h * 2, t.size() - h * 2);
+            else
+                add(x.data(), x.size(), t.data() + h * 2, t.size() - h * 2);
+        }
+        assert(x[n + 1] == 0);
+        x.resize(n + 1);
+        return x;
+    }
+
+    // u[0, 2n) 除以 v[0, n)，要求 u < v * Base^n，x 为 v 的倒数；q[0, n)、r[0, n)
+    // 试商 floor(u / Base^(n-1)) * x / Base^(n+1) 与真实的商只差很小的常数，再逐次修正
+    static void block(const Limb u[], const Limb v[], size_t n, const Vec &x, Limb q[], Limb r[]) {
+        Vec p(n * 2 + 2), t(n * 2 + 1), w(u, u + n * 2);
+        mul(u + n - 1, n + 1, x.data(), n + 1, p.data());
+        Vec s(p.begin() + n + 1, p.end());
+        mul(s.data(), n + 1, v, n, t.data());
+        w.push_back(0);
+        const Limb one = 1;
+        while (cmp(t.data(), t.size(), w.data(), w.size()) > 0) {
+            sub(s.data(), s.size(), &one, 1);
+            sub(t.data(), t.size(), v, n);
+        }
+        sub(w.data(), w.size(), t.data(), t.size());
+        while (cmp(w.data(), w.size(), v, n) >= 0) {
+            add(s.data(), s.size(), &one, 1);
+            sub(w.data(), w.size(), v, n);
+        }
+        assert(s[n] == 0);
+        std::copy(s.begin(), s.begin() + n, q);
+        std::copy(w.begin(), w.begin() + n, r);
+    }
+
+    // q[0, m - n + 1) = a / b，r[0, n) = a % b，要求 m >= n 且 b[n - 1] != 0；q、r 不能与 a、b 重叠
+    static void divide(const Limb a[], size_t m, const Limb b[], size_t n, Limb q[], Limb r[]) {
+        size_t k = m - n + 1;
+        if (n == 1) {
+            std::copy(a, a + m, q);
+            r[0] = div_1(q, m, b[0]);
+            return;
+        }
+        if (n < NEWTON_THRESHOLD || k < NEWTON_THRESHOLD)
+            return knuth(a, m, b, n, q, r);
+        if (n > k + 2) {
+            // 除数比商长得多时只用高位试商，得到的商与真实的商至多差 1，再用完整的乘积修正
+            size_t s = n - k - 2;
+            Vec rr(n - s), t(m + 1), w(a, a + m);
+            divide(a + s, m - s, b + s, n - s, q, rr.data());
+            mul(q, k, b, n, t.data());
+            w.push_back(0);
+            const Limb one = 1;
+            while (cmp(t.data(), t.size(), w.data(), w.size()) > 0) {
+                sub(q, k, &one, 1);
+                sub(t.data(), t.size(), b, n);
+            }
+            sub(w.data(), w.size(), t.data(), t.size());
+            while (cmp(w.data(), w.size(), b, n) >= 0) {
+                add(q, k, &one, 1);
+                sub(w.data(), w.size(), b, n);
+            }
+            std::copy(w.begin(), w.begin() + n, r);
+            return;
+        }
+        // 规范化后按 n 位一段从高到低求商，每段都是 2n 位除以 n 位
+        Limb d = Limb(Base / (Wide(b[n - 1]) + 1));
+        Vec u(a, a + m), v(b, b + n);
+        u.push_back(mul_1(u.data(), m, d));
+        mul_1(v.data(), n, d);
+        Vec x = reciprocal(v.data(), n);
+        size_t blocks = u.size() / n, top = u.size() % n;
+        Vec rem(n), w(n * 2), Q(blocks * n);
+        std::copy(u.end() - top, u.end(), rem.begin());
+        for (size_t i = blocks; i-- > 0;) {
+            std::copy(u.begin() + i * n, u.begin() + (i + 1) * n, w.begin());
+            std::copy(rem.begin(), rem.end(), w.begin() + n);
+            block(w.data(), v.data(), n, x, Q.data() + i * n, rem.data());
+        }
+        assert(trim(Q.data(), Q.size()) <= k);
+        std::fill(std::copy(Q.begin(), Q.begin() + std::min(k, Q.size()), q), q + k, 0);
+        div_1(rem.data(), n, d);
+        std::copy(rem.begin(), rem.end(), r);
+    }
+};
+
+// q[0, m - n + 1) = a / b，r[0, n) = a % b，a、b 均为 Base 进制的小端数组
+// 要求 m >= n 且 b[n - 1] != 0，q、r 不能与 a、b 重叠
+template <class Limb, uint64_t Base>
+void divide(const Limb a[], size_t m, const Limb b[], size_t n, Limb q[], Limb r[]) {
+    BIG_STATS_SCOPE(big_stats::div, m);
+    Divider<Limb, Base>::divide(a, m, b, n, q, r);
+}
+} // namespace Divide
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "Stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// 每个线程的缓存池最多保留的字节数，超出后归还的块直接还给系统
+#ifndef MEMORY_POOL_MAX_BYTES
+#define MEMORY_POOL_MAX_BYTES (size_t(64) << 20)
+#endif
+
+// 不超过该大小的块按 2 的幂分级进池，更大的块直接向系统申请
+#ifndef MEMORY_POOL_MAX_BLOCK
+#define MEMORY_POOL_MAX_BLOCK (size_t(16) << 20)
+#endif
+
+// 不小于该大小的块用 mmap 申请并建议内核使用透明大页，0 表示不使用（仅 Linux 有效）
+#ifndef MEMORY_HUGE_PAGE_THRESHOLD
+#define MEMORY_HUGE_PAGE_THRESHOLD 0
+#endif
+
+// 大整数的数位与变换用的临时缓冲区都从这里申请
+// 默认是每个线程一个的分级缓存池，也可以用 set_allocator 换成别的分配函数
+namespace Memory {
+struct Stats {
+    size_t allocations;        // 申请次数
+    size_t pool_hits;          // 其中由缓存池满足的次数
+    size_t system_allocations; // 向系统申请的次数（含大页）
+    size_t huge_allocations;   // 其中用大页的次数
+    size_t bytes_in_use;       // 尚未归还的字节数
+    size_t peak_bytes;         // bytes_in_use 的最大值
+};
+std::atomic<size_t> allocations, pool_hits, system_allocations, huge_allocations, bytes_in_use, peak_bytes;
+
+Stats stats() {
+    return {allocations.load(),      pool_hits.load(),    system_allocations.load(),
+            huge_allocations.load(), bytes_in_use.load(), peak_bytes.load()};
+}
+// 清零计数，bytes_in_use 保持不变
+void reset_stats() {
+    allocations = pool_hits = system_allocations = huge_allocations = 0;
+    peak_bytes = bytes_in_use.load();
+}
+
+// 直接向系统申请与归还
+void *system_allocate(size_t bytes) {
+    system_allocations.fetch_add(1, std::memory_order_relaxed);
+#if defined(__linux__) && MEMORY_HUGE_PAGE_THRESHOLD > 0
+    if (bytes >= size_t(MEMORY_HUGE_PAGE_THRESHOLD)) {
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        madvise(p, bytes, MADV_HUGEPAGE);
+        huge_allocations.fetch_add(1, std::memory_order_relaxed);
+        return p;
+    }
+#endif
+    void *p = std::malloc(bytes);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+void system_deallocate(void *p, size_t bytes) {
+#if defined(__linux__) && MEMORY_HUGE_PAGE_THRESHOLD > 0
+    if (bytes >= size_t(MEMORY_HUGE_PAGE_THRESHOLD))
+        return void(munmap(p, bytes));
+#else
+    (void)bytes;
+#endif
+    std::free(p);
+}
+
+// 分级缓存池：第 k 级保存大小为 2^k 字节的空闲块，块都来自 system_allocate，可以在别的线程归还
+struct Pool {
+    std::vector<void *> free[64];
+    size_t cached = 0;
+    ~Pool();
+};
+thread_local Pool pool;
+// 线程退出时 pool 先于静态对象析构，此后的申请与归还直接走系统
+thread_local bool pool_destroyed = false;
+Pool::~Pool() {
+    for (int k = 0; k < 64; k++)
+        for (void *p : free[k])
+            system_deallocate(p, size_t(1) << k);
+    pool_destroyed = true;
+}
+// 能容纳 bytes 的最小级别，至少 64 字节
+int size_class(size_t bytes) { return bytes <= 64 ? 6 : std::__lg(bytes - 1) + 1; }
+
+// 不超过 MEMORY_POOL_MAX_BLOCK 的块无论是否进池都按级别大小向系统申请与归还，
+// 两边的大小一致，归还时才能正确判断是否为大页
+void *pool_allocate(size_t bytes) {
+    if (bytes > MEMORY_POOL_MAX_BLOCK)
+        return system_allocate(bytes);
+    int k = size_class(bytes);
+    std::vector<void *> &list = pool.free[k];
+    if (pool_destroyed || list.empty())
+        return system_allocate(size_t(1) << k);
+    void *p = list.back();
+    list.pop_back();
+    pool.cached -= size_t(1) << k;
+    pool_hits.fetch_add(1, std::memory_order_relaxed);
+    return p;
+}
+void pool_deallocate(void *p, size_t bytes) {
+    if (bytes > MEMORY_POOL_MAX_BLOCK)
+        return system_deallocate(p, bytes);
+    int k = size_class(bytes);
+    if (pool_destroyed || pool.cached + (size_t(1) << k) > MEMORY_POOL_MAX_BYTES)
+        return system_deallocate(p, size_t(1) << k);
+    pool.free[k].push_back(p);
+    pool.cached += size_t(1) << k;
+}
+
+// 分配函数对，deallocate 收到的 bytes 与申请时相同
+struct Allocator {
+    void *(*allocate)(size_t bytes);
+    void (*deallocate)(void *p, size_t bytes);
+};
+Allocator hook = {pool_allocate, pool_deallocate};
+// 应在申请任何缓冲区之前设置，否则已有的块会被还给不同的分配函数
+void set_allocator(Allocator a) { hook = a; }
+
+// 未初始化的 n 个 T
+template <class T> T *allocate(size_t n) {
+    size_t bytes = n * sizeof(T);
+    BIG_STATS_ALLOCATE(bytes);
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t now = bytes_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (now > peak && !peak_bytes.compare_exchange_weak(peak, now, std::memory_order_relaxed))
+        ;
+    return static_cast<T *>(hook.allocate(bytes));
+}
+template <class T> void deallocate(T *p, size_t n) {
+    bytes_in_use.fetch_sub(n * sizeof(T), std::memory_order_relaxed);
+    hook.deallocate(p, n * sizeof(T));
+}
+
+// 给 std::vector 用的分配器，临时缓冲区写作 Memory::vector<T>
+template <class T> struct allocator {
+    using value_type = T;
+    allocator() = default;
+    template <class U> allocator(const allocator<U> &) {}
+    T *allocate(size_t n) { return Memory::allocate<T>(n); }
+    void deallocate(T *p, size_t n) { Memory::deallocate(p, n); }
+    template <class U> bool operator==(const allocator<U> &) const { return true; }
+    template <class U> bool operator!=(const allocator<U> &) const { return false; }
+};
+template <class T> using vector = std::vector<T, allocator<T>>;
+
+// 工作区：运算的临时空间按栈的方式从这里取用，Frame 结束时归还
+// 空间只增不减，同样规模的运算反复进行时不再申请内存；一个工作区不能同时在多个线程中使用
+class Workspace {
+  public:
+    Workspace() {}
+    Workspace(const Workspace &) = delete;
+    Workspace &operator=(const Workspace &) = delete;
+    ~Workspace() { shrink_to_fit(); }
+
+    // n 个未初始化的 T，每段按 64 字节取整
+    template <class T> T *take(size_t n) {
+        size_t bytes = (n * sizeof(T) + 63) / 64 * 64;
+        if (bytes == 0)
+            return nullptr;
+        while (block < blocks.size() && top + bytes > blocks[block].size)
+            block++, top = 0;
+        if (block == blocks.size()) {
+            size_t s = std::max(bytes, size() * 2);
+            blocks.push_back({Memory::allocate<unsigned char>(s), s});
+        }
+        T *r = reinterpret_cast<T *>(blocks[block].p + top);
+        top += bytes;
+        return r;
+    }
+    // 已持有的字节数
+    size_t size() const {
+        size_t s = 0;
+        for (const Block &b : blocks)
+            s += b.size;
+        return s;
+    }
+    // 归还全部空间，要求没有正在使用的部分
+    void shrink_to_fit() {
+        assert(block == 0 && top == 0);
+        for (const Block &b : blocks)
+            Memory::deallocate(b.p, b.size);
+        blocks.clear();
+    }
+
+    // 记录当前位置，结束时归还之后取用的全部空间
+    // 最外层结束时若空间分成了多块，合并成一块，下次同样规模的运算只用一块
+    class Frame {
+      public:
+        explicit Frame(Workspace &ws) : ws(ws), block(ws.block), top(ws.top) {}
+        Frame(const Frame &) = delete;
+        ~Frame() {
+            ws.block = block, ws.top = top;
+            if (block == 0 && top == 0 && ws.blocks.size() > 1) {
+                size_t s = ws.size();
+                ws.shrink_to_fit();
+                ws.blocks.push_back({Memory::allocate<unsigned char>(s), s});
+            }
+        }
+
+      private:
+        Workspace &ws;
+        size_t block, top;
+    };
+
+  private:
+    struct Block {
+        unsigned char *p;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t block = 0, top = 0; // 正在使用的块及其中已用的字节数
+};
+// 每个线程默认使用的工作区
+Workspace &workspace() {
+    thread_local Workspace ws;
+    return ws;
+}
+} // namespace Memory
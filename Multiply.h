@@ -0,0 +1,434 @@
+#pragma once
+
+#include "NTT.h"
+#include "Decimal.h"
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+// Tune.cpp 在本机测出的阈值，没有时使用下面的默认值
+#if __has_include("MultiplyConfig.h")
+#include "MultiplyConfig.h"
+#endif
+#ifndef MULTIPLY_KARATSUBA_THRESHOLD
+#define MULTIPLY_KARATSUBA_THRESHOLD 48
+#endif
+#ifndef MULTIPLY_TOOM3_THRESHOLD
+#define MULTIPLY_TOOM3_THRESHOLD 150
+#endif
+// 有 SIMD 内核时 NTT 的交叉点约为 100 位，只有标量内核时约为 600 位
+#ifndef MULTIPLY_NTT_THRESHOLD
+#define MULTIPLY_NTT_THRESHOLD (NTT::cpu_isa() == NTT::Isa::scalar ? 640 : 128)
+#endif
+
+// 按规模分层的乘法：朴素乘法、Karatsuba、Toom-3、三模数 NTT
+// 中间结果是不进位的 long long 系数，只在最后统一进位
+namespace Multiply {
+// 切换阈值，均以较短乘数的位数计
+size_t KARATSUBA_THRESHOLD = MULTIPLY_KARATSUBA_THRESHOLD;
+size_t TOOM3_THRESHOLD = MULTIPLY_TOOM3_THRESHOLD;
+size_t NTT_THRESHOLD = MULTIPLY_NTT_THRESHOLD;
+
+// 递归用的草稿区：按值传递，子调用取走的空间在返回后自动归还
+struct Scratch {
+    long long *p, *end;
+    long long *take(size_t n) {
+        assert(p + n <= end);
+        long long *r = p;
+        p += n;
+        return r;
+    }
+};
+// 乘积为 al + bl 位时草稿区大小的上界
+constexpr size_t scratch_size(size_t al, size_t bl) { return 8 * (al + bl) + 256; }
+
+// c[0, al + bl - 1) = a * b
+void schoolbook(const long long a[], size_t al, const long long b[], size_t bl, long long c[]) {
+    std::fill(c, c + al + bl - 1, 0);
+    for (size_t i = 0; i < al; i++)
+        for (size_t j = 0; j < bl; j++)
+            c[i + j] += a[i] * b[j];
+}
+
+// c[0, al * 2 - 1) = a * a，交叉项只算一次再乘 2
+void schoolbook_sqr(const long long a[], size_t al, long long c[]) {
+    std::fill(c, c + al * 2 - 1, 0);
+    for (size_t i = 0; i < al; i++)
+        for (size_t j = i + 1; j < al; j++)
+            c[i + j] += a[i] * a[j];
+    for (size_t i = 0; i < al * 2 - 1; i++)
+        c[i] *= 2;
+    for (size_t i = 0; i < al; i++)
+        c[i * 2] += a[i] * a[i];
+}
+
+void mul(const long long a[], size_t al, const long long b[], size_t bl, long long c[], Scratch s);
+void sqr(const long long a[], size_t al, long long c[], Scratch s);
+
+// c 的低位已有 z0（长 2m - 1），高位从 2m 起已有 z2（长 hl），z1 = (a0 + a1)(b0 + b1)
+// 把 (z1 - z0 - z2) x^m 加到 c[0, n) 上
+void karatsuba_combine(long long c[], long long z1[], size_t m, size_t hl, size_t n) {
+    for (size_t i = 0; i < m * 2 - 1; i++)
+        z1[i] -= c[i];
+    for (size_t i = 0; i < hl; i++)
+        z1[i] -= c[m * 2 + i];
+    for (size_t i = 0; i < m * 2 - 1 && m + i < n; i++)
+        c[m + i] += z1[i];
+}
+
+// a = a0 + a1 x^m，b = b0 + b1 x^m，要求 al >= bl > m
+void karatsuba(const long long a[], size_t al, const long long b[], size_t bl, long long c[],
+               Scratch s) {
+    size_t m = (al + 1) / 2, n = al + bl - 1;
+    long long *sa = s.take(m), *sb = s.take(m), *z1 = s.take(m * 2 - 1);
+    for (size_t i = 0; i < m; i++) {
+        sa[i] = a[i] + (i < al - m ? a[m + i] : 0);
+        sb[i] = b[i] + (i < bl - m ? b[m + i] : 0);
+    }
+    // z0 和 z2 直接写进 c 的低位和高位，两者不重叠
+    mul(a, m, b, m, c, s);
+    c[m * 2 - 1] = 0;
+    mul(a + m, al - m, b + m, bl - m, c + m * 2, s);
+    mul(sa, m, sb, m, z1, s);
+    karatsuba_combine(c, z1, m, al + bl - m * 2 - 1, n);
+}
+
+// 平方：三次子乘法都是平方
+void karatsuba_sqr(const long long a[], size_t al, long long c[], Scratch s) {
+    size_t m = (al + 1) / 2, n = al * 2 - 1;
+    long long *sa = s.take(m), *z1 = s.take(m * 2 - 1);
+    for (size_t i = 0; i < m; i++)
+        sa[i] = a[i] + (i < al - m ? a[m + i] : 0);
+    sqr(a, m, c, s);
+    c[m * 2 - 1] = 0;
+    sqr(a + m, al - m, c + m * 2, s);
+    sqr(sa, m, z1, s);
+    karatsuba_combine(c, z1, m, (al - m) * 2 - 1, n);
+}
+
+// Toom-3 的求值：x = x0 + x1 t^k + x2 t^2k 在 1, -1, -2 处的值
+void toom3_eval(const long long x[], size_t k, size_t x2l, long long p[]) {
+    long long *p1 = p, *pm1 = p + k, *pm2 = p + k * 2;
+    for (size_t i = 0; i < k; i++) {
+        long long x0 = x[i], x1 = x[k + i], x2 = i < x2l ? x[k * 2 + i] : 0;
+        p1[i] = x0 + x1 + x2;
+        pm1[i] = x0 - x1 + x2;
+        pm2[i] = x0 - x1 * 2 + x2 * 4;
+    }
+}
+
+// Toom-3 的插值：c 的低位已有 r0，从 4k 起已有 r∞（长 infl），r 中依次为 r1、r-1、r-2
+// 按 Bodrato 的顺序解出中间三项后加到 c[0, n) 上
+void toom3_interpolate(long long c[], long long r[], size_t k, size_t infl, size_t n) {
+    long long *r1 = r, *rm1 = r + k * 2, *rm2 = r + k * 4;
+    for (size_t i = 0; i < k * 2 - 1; i++) {
+        long long r0 = c[i], rinf = i < infl ? c[k * 4 + i] : 0;
+        long long t3 = (rm2[i] - r1[i]) / 3;
+        long long t1 = (r1[i] - rm1[i]) / 2;
+        long long t2 = rm1[i] - r0;
+        t3 = (t2 - t3) / 2 + rinf * 2;
+        t2 = t2 + t1 - rinf;
+        t1 = t1 - t3;
+        r1[i] = t1, rm1[i] = t2, rm2[i] = t3;
+    }
+    for (size_t i = 0; i < k * 2 - 1; i++) {
+        c[k + i] += r1[i];
+        c[k * 2 + i] += rm1[i];
+        if (k * 3 + i < n)
+            c[k * 3 + i] += rm2[i];
+    }
+}
+
+// Toom-3：分成三段，在 0, 1, -1, -2, ∞ 处求值，按 Bodrato 的顺序插值
+// 要求 al >= bl > 2k，k = ceil(al / 3)
+void toom3(const long long a[], size_t al, const long long b[], size_t bl, long long c[],
+           Scratch s) {
+    size_t k = (al + 2) / 3, n = al + bl - 1;
+    size_t a2l = al - k * 2, b2l = bl - k * 2;
+    long long *pa = s.take(k * 3), *pb = s.take(k * 3), *r = s.take(k * 2 * 3);
+    toom3_eval(a, k, a2l, pa);
+    toom3_eval(b, k, b2l, pb);
+    // r0 和 r∞ 直接写进 c 的低位和高位
+    mul(a, k, b, k, c, s);
+    c[k * 2 - 1] = 0;
+    mul(a + k * 2, a2l, b + k * 2, b2l, c + k * 4, s);
+    std::fill(c + k * 2, c + k * 4, 0);
+    for (size_t j = 0; j < 3; j++)
+        mul(pa + k * j, k, pb + k * j, k, r + k * 2 * j, s);
+    toom3_interpolate(c, r, k, a2l + b2l - 1, n);
+}
+
+// 平方：五次子乘法都是平方
+void toom3_sqr(const long long a[], size_t al, long long c[], Scratch s) {
+    size_t k = (al + 2) / 3, n = al * 2 - 1, a2l = al - k * 2;
+    long long *pa = s.take(k * 3), *r = s.take(k * 2 * 3);
+    toom3_eval(a, k, a2l, pa);
+    sqr(a, k, c, s);
+    c[k * 2 - 1] = 0;
+    sqr(a + k * 2, a2l, c + k * 4, s);
+    std::fill(c + k * 2, c + k * 4, 0);
+    for (size_t j = 0; j < 3; j++)
+        sqr(pa + k * j, k, r + k * 2 * j, s);
+    toom3_interpolate(c, r, k, a2l * 2 - 1, n);
+}
+
+// c[0, al + bl - 1) = a * b，按规模选择算法
+void mul(const long long a[], size_t al, const long long b[], size_t bl, long long c[], Scratch s) {
+    if (al < bl)
+        std::swap(a, b), std::swap(al, bl);
+    if (bl < KARATSUBA_THRESHOLD)
+        return schoolbook(a, al, b, bl, c);
+    if (bl * 2 <= al) {
+        // 长短悬殊时把长的切成若干段，每段与短的做平衡乘法
+        long long *t = s.take(bl * 2);
+        std::fill(c, c + al + bl - 1, 0);
+        for (size_t i = 0; i < al; i += bl) {
+            size_t l = std::min(bl, al - i);
+            mul(a + i, l, b, bl, t, s);
+            for (size_t j = 0; j < l + bl - 1; j++)
+                c[i + j] += t[j];
+        }
+        return;
+    }
+    if (bl >= TOOM3_THRESHOLD && bl > (al + 2) / 3 * 2)
+        return toom3(a, al, b, bl, c, s);
+    return karatsuba(a, al, b, bl, c, s);
+}
+
+// c[0, al * 2 - 1) = a * a，按规模选择算法
+void sqr(const long long a[], size_t al, long long c[], Scratch s) {
+    if (al < KARATSUBA_THRESHOLD)
+        return schoolbook_sqr(a, al, c);
+    if (al >= TOOM3_THRESHOLD && al > (al + 2) / 3 * 2)
+        return toom3_sqr(a, al, c, s);
+    return karatsuba_sqr(a, al, c, s);
+}
+
+// 较短乘数有 m 个系数时分层乘法顶层所用的算法，只用于统计
+big_stats::Algorithm tier(size_t m) {
+    if (m < KARATSUBA_THRESHOLD)
+        return big_stats::schoolbook;
+    return m < TOOM3_THRESHOLD ? big_stats::karatsuba : big_stats::toom3;
+}
+
+// 把不进位的系数 t[0, n) 进位后写入 c[0, n]
+void carry(const long long t[], size_t n, int c[]) {
+    BIG_STATS_SCOPE(big_stats::carry, n);
+    const long long base = 10000;
+    long long carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        carry += t[i];
+        c[i] = carry % base;
+        carry /= base;
+    }
+    c[n] = carry;
+}
+
+// c[0, al * 2) = a * a，c 可以与 a 相同，临时空间从 ws 中取用
+void square(const int a[], size_t al, int c[], Memory::Workspace &ws = Memory::workspace()) {
+    BIG_STATS_SCOPE(big_stats::square, al);
+    if (al == 0)
+        return;
+    if (al >= NTT_THRESHOLD)
+        return NTT::square(a, al, c, ws);
+    BIG_STATS_ALGORITHM(tier(al));
+    Memory::Workspace::Frame frame(ws);
+    size_t n = al * 2 - 1;
+    if (al < KARATSUBA_THRESHOLD) {
+        // 位数较少时直接在栈上算，交叉项只算一次
+        long long buffer[256];
+        long long *t = n > 256 ? ws.take<long long>(n) : buffer;
+        std::fill(t, t + n, 0);
+        for (size_t i = 0; i < al; i++)
+            for (size_t j = i + 1; j < al; j++)
+                t[i + j] += 1LL * a[i] * a[j];
+        for (size_t i = 0; i < n; i++)
+            t[i] *= 2;
+        for (size_t i = 0; i < al; i++)
+            t[i * 2] += 1LL * a[i] * a[i];
+        return carry(t, n, c);
+    }
+    long long *A = ws.take<long long>(al), *C = ws.take<long long>(n);
+    long long *buffer = ws.take<long long>(scratch_size(al, al));
+    std::copy(a, a + al, A);
+    sqr(A, al, C, Scratch{buffer, buffer + scratch_size(al, al)});
+    carry(C, n, c);
+}
+
+// c[0, al + bl) = a * b，a、b、c 均为 10^4 进制的小端数组，c 可以与 a 或 b 相同
+// a 与 b 是同一个数组时按平方计算；临时空间从 ws 中取用
+void multiply(const int a[], size_t al, const int b[], size_t bl, int c[],
+              Memory::Workspace &ws = Memory::workspace()) {
+    BIG_STATS_SCOPE(a == b && al == bl ? big_stats::square : big_stats::mul, std::max(al, bl));
+    if (al == 0 || bl == 0) {
+        std::fill(c, c + al + bl, 0);
+        return;
+    }
+    if (a == b && al == bl)
+        return square(a, al, c, ws);
+    if (std::min(al, bl) >= NTT_THRESHOLD)
+        return NTT::multiply(a, al, b, bl, c, ws);
+    BIG_STATS_ALGORITHM(tier(std::min(al, bl)));
+    Memory::Workspace::Frame frame(ws);
+    size_t n = al + bl - 1;
+    if (std::min(al, bl) < KARATSUBA_THRESHOLD) {
+        // 位数较少时直接在栈上算
+        long long buffer[256];
+        long long *t = n > 256 ? ws.take<long long>(n) : buffer;
+        for (size_t k = 0; k < n; k++) {
+            long long tmp = 0;
+            size_t lo = k >= bl ? k - bl + 1 : 0, hi = std::min(k, al - 1);
+            for (size_t i = lo; i <= hi; i++)
+                tmp += 1LL * a[i] * b[k - i];
+            t[k] = tmp;
+        }
+        return carry(t, n, c);
+    }
+    long long *A = ws.take<long long>(al), *B = ws.take<long long>(bl), *C = ws.take<long long>(n);
+    long long *buffer = ws.take<long long>(scratch_size(al, bl));
+    std::copy(a, a + al, A);
+    std::copy(b, b + bl, B);
+    mul(A, al, B, bl, C, Scratch{buffer, buffer + scratch_size(al, bl)});
+    carry(C, n, c);
+}
+
+// 不取用工作区的 multiply 所需草稿区的大小（long long 个数）
+constexpr size_t multiply_scratch_size(size_t al, size_t bl) { return (al + bl) * 2 + scratch_size(al, bl); }
+
+// c[0, al + bl) = a * b，10^4 进制，c 可以与 a 或 b 相同，a 与 b 是同一个数组时按平方计算
+// 只用朴素乘法、Karatsuba 与 Toom-3，临时空间全部取自 s（至少 multiply_scratch_size(al, bl) 个），
+// 不分配内存；定长的 big_int、big_uint 在栈上备好 s 后调用它
+void multiply(const int a[], size_t al, const int b[], size_t bl, int c[], Scratch s) {
+    bool same = a == b && al == bl;
+    BIG_STATS_SCOPE(same ? big_stats::square : big_stats::mul, std::max(al, bl));
+    if (al == 0 || bl == 0) {
+        std::fill(c, c + al + bl, 0);
+        return;
+    }
+    BIG_STATS_ALGORITHM(tier(std::min(al, bl)));
+    size_t n = al + bl - 1;
+    long long *A = s.take(al), *B = same ? A : s.take(bl), *C = s.take(n);
+    std::copy(a, a + al, A);
+    std::copy(b, b + bl, B);
+    if (same)
+        sqr(A, al, C, s);
+    else
+        mul(A, al, B, bl, C, s);
+    carry(C, n, c);
+}
+
+// c[0, al + bl) = a * b，a、b、c 均为 2^32 进制的小端数组，c 可以与 a 或 b 相同
+// 位数较少时直接用 64 位乘积做朴素乘法；否则把每位拆成两个 16 位系数，
+// 复用上面的分层乘法，阈值按 16 位系数的个数比较
+void multiply(const uint32_t a[], size_t al, const uint32_t b[], size_t bl, uint32_t c[],
+              Memory::Workspace &ws = Memory::workspace()) {
+    if (al == 0 || bl == 0) {
+        std::fill(c, c + al + bl, 0);
+        return;
+    }
+    bool same = a == b && al == bl;
+    BIG_STATS_SCOPE(same ? big_stats::square : big_stats::mul, std::max(al, bl));
+    size_t m = std::min(al, bl) * 2;
+    if (m >= NTT_THRESHOLD)
+        return NTT::multiply(a, al, b, bl, c, ws);
+    BIG_STATS_ALGORITHM(tier(m));
+    Memory::Workspace::Frame frame(ws);
+    if (m < KARATSUBA_THRESHOLD) {
+        uint32_t buffer[256];
+        uint32_t *t = al + bl > 256 ? ws.take<uint32_t>(al + bl) : buffer;
+        std::fill(t, t + al + bl, 0);
+        for (size_t i = 0; i < al; i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < bl; j++) {
+                carry += uint64_t(a[i]) * b[j] + t[i + j];
+                t[i + j] = uint32_t(carry);
+                carry >>= 32;
+            }
+            t[i + bl] = uint32_t(carry);
+        }
+        std::copy(t, t + al + bl, c);
+        return;
+    }
+    auto split = [&](const uint32_t x[], size_t l) {
+        long long *y = ws.take<long long>(l * 2);
+        for (size_t i = 0; i < l; i++)
+            y[i * 2] = x[i] & 0xFFFF, y[i * 2 + 1] = x[i] >> 16;
+        return y;
+    };
+    size_t n = (al + bl) * 2 - 1;
+    long long *A = split(a, al), *B = same ? A : split(b, bl), *C = ws.take<long long>(n);
+    long long *buffer = ws.take<long long>(scratch_size(al * 2, bl * 2));
+    Scratch s{buffer, buffer + scratch_size(al * 2, bl * 2)};
+    if (same)
+        sqr(A, al * 2, C, s);
+    else
+        mul(A, al * 2, B, bl * 2, C, s);
+    // 卷积系数都是非负的，不超过 min(al, bl) * 2^33，进位用 64 位即可
+    BIG_STATS_SCOPE(big_stats::carry, al + bl);
+    unsigned long long carry = 0;
+    for (size_t i = 0; i < al + bl; i++) {
+        carry += C[i * 2];
+        uint32_t lo = uint32_t(carry) & 0xFFFF;
+        carry = (carry >> 16) + (i * 2 + 1 < n ? C[i * 2 + 1] : 0);
+        c[i] = lo | uint32_t(carry) << 16;
+        carry >>= 16;
+    }
+    assert(carry == 0);
+}
+
+// c[0, al + bl) = a * b，a、b、c 均为 Base = 10^K 进制的小端数组，c 可以与 a 或 b 相同
+// int 的 10^4 进制直接使用上面的版本；其他进制位数较少时用宽一倍的乘积做朴素乘法，
+// 否则重新分组为 10^4 进制后使用分层乘法，NTT 的系数界与进制无关
+template <class Limb, Limb Base>
+void multiply(const Limb a[], size_t al, const Limb b[], size_t bl, Limb c[],
+              Memory::Workspace &ws = Memory::workspace()) {
+    constexpr size_t K = Decimal::exponent(Base);
+    static_assert(K > 0 && (K <= 9 || K == 18), "Base 应为 10^1 到 10^9 或 10^18");
+    if constexpr (K == 4 && std::is_same_v<Limb, int>) {
+        multiply(a, al, b, bl, c, ws);
+    } else {
+        BIG_STATS_SCOPE(a == b && al == bl ? big_stats::square : big_stats::mul, std::max(al, bl));
+        if (al == 0 || bl == 0) {
+            std::fill(c, c + al + bl, 0);
+            return;
+        }
+        Memory::Workspace::Frame frame(ws);
+        if (std::min(al, bl) * K < KARATSUBA_THRESHOLD * 4) {
+            BIG_STATS_ALGORITHM(big_stats::schoolbook);
+            using Wide = std::conditional_t<K <= 9, uint64_t, unsigned __int128>;
+            Limb *t = ws.take<Limb>(al + bl);
+            std::fill(t, t + al + bl, 0);
+            for (size_t i = 0; i < al; i++) {
+                Limb carry = 0;
+                for (size_t j = 0; j < bl; j++) {
+                    Wide x = Wide(a[i]) * b[j] + t[i + j] + carry;
+                    t[i + j] = Limb(x % Base);
+                    carry = Limb(x / Base);
+                }
+                t[i + bl] = carry;
+            }
+            std::copy(t, t + al + bl, c);
+            return;
+        }
+        bool same = a == b && al == bl;
+        int *A = ws.take<int>((al * K + 3) / 4), *B = same ? A : ws.take<int>((bl * K + 3) / 4);
+        size_t Al = Decimal::regroup<K, 4>(a, al, A);
+        size_t Bl = same ? Al : Decimal::regroup<K, 4>(b, bl, B);
+        int *C = ws.take<int>(Al + Bl);
+        multiply(A, Al, B, Bl, C, ws);
+        // 转回 10^K 进制，超过 9 位时先转成 10^(K/2) 进制再两两合并
+        constexpr size_t Q = K <= 9 ? K : K / 2;
+        uint64_t *r = ws.take<uint64_t>(((Al + Bl) * 4 + Q - 1) / Q);
+        size_t m = Decimal::regroup<4, Q>(C, Al + Bl, r);
+        if constexpr (K <= 9) {
+            for (size_t i = 0; i < al + bl; i++)
+                c[i] = i < m ? Limb(r[i]) : 0;
+        } else {
+            for (size_t i = 0; i < al + bl; i++)
+                c[i] = Limb((i * 2 < m ? r[i * 2] : 0) + (i * 2 + 1 < m ? r[i * 2 + 1] : 0) * Decimal::power(Q));
+        }
+    }
+}
+} // namespace Multiply
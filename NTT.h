@@ -1,5 +1,29 @@
+#pragma once
+
+#include "Memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NTT_SIMD
+#include <immintrin.h>
+#endif
+
 namespace NTT {
 const int P1 = 469762049, P2 = 167772161, G = 3;
 int ksm(int a, int b, int P) {
@@ -12,6 +36,570 @@ int ksm(int a, int b, int P) {
 int inv(int a, int P) { return ksm(a, P - 2, P); }
 const int P1_inv = inv(P1, P2);
 
+// 模 P 的最小原根
+int root(int P) {
+    std::vector<int> factors;
+    int m = P - 1;
+    for (int d = 2; 1LL * d * d <= m; d++) {
+        if (m % d == 0)
+            factors.push_back(d);
+        while (m % d == 0)
+            m /= d;
+    }
+    if (m > 1)
+        factors.push_back(m);
+    for (int g = 2;; g++) {
+        bool ok = true;
+        for (int f : factors)
+            ok = ok && ksm(g, (P - 1) / f, P) != 1;
+        if (ok)
+            return g;
+    }
+}
+
+// Montgomery 模乘，R = 2^32，模数为编译期常量以便编译器特化
+// 所有值都只做惰性约简，保持在 [0, 2P) 内，因此要求 P < 2^30
+template <uint32_t Mod> struct Montgomery {
+    static_assert(Mod % 2 == 1 && Mod < (1u << 30), "modulus must be odd and below 2^30");
+    static constexpr uint32_t P = Mod, P2 = Mod * 2;
+    // P^{-1} mod 2^32，牛顿迭代每次使正确的位数翻倍
+    static constexpr uint32_t P_inv = [] {
+        uint32_t x = Mod;
+        for (int i = 0; i < 4; i++)
+            x *= 2 - Mod * x;
+        return x;
+    }();
+    static constexpr uint32_t R = (1ULL << 32) % Mod, R2 = 1ULL * R * R % Mod;
+
+    // a * b * R^{-1} mod P，要求 a * b < P * 2^32，结果在 [0, 2P)
+    static uint32_t mul(uint32_t a, uint32_t b) {
+        uint64_t t = 1ULL * a * b;
+        uint32_t m = uint32_t(t) * P_inv;
+        return uint32_t(t >> 32) - uint32_t(1ULL * m * P >> 32) + P;
+    }
+    // [0, 4P) -> [0, 2P)
+    static uint32_t shrink2(uint32_t a) { return a >= P2 ? a - P2 : a; }
+    // [0, 2P) -> [0, P)
+    static uint32_t shrink(uint32_t a) { return a >= P ? a - P : a; }
+    // 转入 Montgomery 形式：a * R mod P
+    static uint32_t to(uint32_t a) { return shrink(mul(a, R2)); }
+    // 普通形式下的精确乘积 a * b mod P，结果在 [0, P)
+    static uint32_t mul_exact(uint32_t a, uint32_t b) { return shrink(mul(mul(a, b), R2)); }
+};
+
+// 变换计划：长度为 n 的位逆序置换和每一层的单位根表
+// 位逆序置换只保存需要交换的下标对 (i, rev[i])，i < rev[i]，避免难以预测的分支
+// w[0] 为正变换、w[1] 为逆变换，第 h 层（蝴蝶跨度 h）的单位根存放在 w[.][h, 2h)
+// 单位根以 Montgomery 形式保存，与普通形式的数据相乘即得普通形式的乘积
+struct Plan {
+    int P = 0;
+    size_t n = 0;
+    std::vector<uint32_t> swaps;
+    std::vector<uint32_t> w[2];
+
+    Plan(int P, size_t n) : P(P), n(n) {
+        std::vector<uint32_t> rev(n);
+        for (size_t i = 1; i < n; i++) {
+            rev[i] = (rev[i >> 1] >> 1) | ((i & 1) ? n >> 1 : 0);
+            if (i < rev[i])
+                swaps.push_back(i), swaps.push_back(rev[i]);
+        }
+        int g = root(P);
+        int roots[2] = {g, inv(g, P)};
+        for (int d = 0; d < 2; d++) {
+            w[d].assign(std::max<size_t>(n, 2), 0);
+            for (size_t h = 1; h < n; h <<= 1) {
+                int gn = ksm(roots[d], (P - 1) / (h * 2), P), g0 = 1;
+                for (size_t k = h; k < h * 2; k++, g0 = 1LL * g0 * gn % P)
+                    w[d][k] = (1ULL * g0 << 32) % P;
+            }
+        }
+    }
+    size_t bytes() const { return (swaps.size() + w[0].size() + w[1].size()) * sizeof(uint32_t); }
+};
+
+// 进程级计划缓存，按 (模数, 长度) 索引，线程安全
+// 超过内存上限时按最近最少使用的顺序淘汰；正在使用的计划由 shared_ptr 保活
+class PlanCache {
+  public:
+    static PlanCache &instance() {
+        static PlanCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<const Plan> get(int P, size_t n) {
+        if (auto plan = find(P, n))
+            return plan;
+        // 生成计划不持锁，其他线程可以同时取用已有的计划；同时生成同一个计划时保留先放入的
+        auto plan = std::make_shared<const Plan>(P, n);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = plans.find({P, n});
+        if (it != plans.end()) {
+            order.splice(order.begin(), order, it->second.second);
+            return it->second.first;
+        }
+        order.push_front({P, n});
+        plans[{P, n}] = {plan, order.begin()};
+        bytes += plan->bytes();
+        evict();
+        return plan;
+    }
+    void set_limit(size_t new_limit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        limit = new_limit;
+        evict();
+    }
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return bytes;
+    }
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        plans.clear();
+        order.clear();
+        bytes = 0;
+    }
+
+  private:
+    using key_type = std::pair<int, size_t>;
+
+    std::shared_ptr<const Plan> find(int P, size_t n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = plans.find({P, n});
+        if (it == plans.end())
+            return nullptr;
+        order.splice(order.begin(), order, it->second.second);
+        return it->second.first;
+    }
+
+    // 至少保留最近使用的一个计划
+    void evict() {
+        while (bytes > limit && order.size() > 1) {
+            auto it = plans.find(order.back());
+            bytes -= it->second.first->bytes();
+            plans.erase(it);
+            order.pop_back();
+        }
+    }
+
+    std::mutex mutex;
+    std::list<key_type> order;
+    std::map<key_type, std::pair<std::shared_ptr<const Plan>, std::list<key_type>::iterator>> plans;
+    size_t bytes = 0;
+    // 默认上限 576MB：每个计划约 12n 字节，恰好容纳最长变换（n = 2^24）的三个模数的计划
+    size_t limit = size_t(576) << 20;
+};
+
+std::shared_ptr<const Plan> plan(int P, size_t n) { return PlanCache::instance().get(P, n); }
+// 预热：生成 2, 4, ..., n 所有长度的计划
+void warm(int P, size_t n) {
+    for (size_t i = 2; i <= n; i <<= 1)
+        PlanCache::instance().get(P, i);
+}
+void set_cache_limit(size_t bytes) { PlanCache::instance().set_limit(bytes); }
+size_t cache_size() { return PlanCache::instance().size(); }
+void clear_cache() { PlanCache::instance().clear(); }
+
+// 指令集：运行时检测 CPU 特性后选择向量化内核，标量内核作为后备
+enum class Isa { scalar, avx2, avx512 };
+Isa cpu_isa() {
+#ifdef NTT_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return Isa::avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return Isa::avx2;
+#endif
+    return Isa::scalar;
+}
+Isa &active_isa() {
+    static Isa isa = cpu_isa();
+    return isa;
+}
+// 限制使用的指令集（不会超过 CPU 支持的范围），用于测试和对比
+void set_isa(Isa isa) { active_isa() = std::min(isa, cpu_isa()); }
+
+// 标量内核
+template <uint32_t Mod> struct Scalar {
+    using M = Montgomery<Mod>;
+    // 一组蝴蝶：l[k], r[k] <- l[k] + w[k] r[k], l[k] - w[k] r[k]，k < len
+    static void block(uint32_t l[], uint32_t r[], const uint32_t w[], size_t len) {
+        for (size_t k = 0; k < len; ++k) {
+            uint32_t x = l[k], y = M::mul(w[k], r[k]);
+            l[k] = M::shrink2(x + y);
+            r[k] = M::shrink2(x + M::P2 - y);
+        }
+    }
+    // 跨度为 h 的一层蝴蝶
+    static void stage(uint32_t a[], size_t n, size_t h, const uint32_t w[]) {
+        for (size_t j = 0; j < n; j += h * 2)
+            block(a + j, a + j + h, w, h);
+    }
+    static void pointwise(uint32_t c[], const uint32_t a[], const uint32_t b[], size_t n) {
+        for (size_t i = 0; i < n; i++)
+            c[i] = M::mul_exact(a[i], b[i]);
+    }
+    // a[i] = a[i] * s * R^{-1}，结果在 [0, P)
+    static void scale(uint32_t a[], size_t n, uint32_t s) {
+        for (size_t i = 0; i < n; i++)
+            a[i] = M::shrink(M::mul(a[i], s));
+    }
+    static void reduce(uint32_t a[], size_t n) {
+        for (size_t i = 0; i < n; i++)
+            a[i] = M::shrink(a[i]);
+    }
+};
+
+#ifdef NTT_SIMD
+#define NTT_AVX2 __attribute__((target("avx2")))
+#define NTT_AVX512 __attribute__((target("avx512f")))
+
+// AVX2 内核：每次 8 个 32 位 Montgomery 乘法
+template <uint32_t Mod> struct Avx2 {
+    using M = Montgomery<Mod>;
+    static constexpr size_t lanes = 8;
+
+    NTT_AVX2 static __m256i mul(__m256i a, __m256i b) {
+        const __m256i p = _mm256_set1_epi32(M::P), p_inv = _mm256_set1_epi32(M::P_inv);
+        __m256i t0 = _mm256_mul_epu32(a, b);
+        __m256i t1 = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        __m256i m0 = _mm256_mul_epu32(_mm256_mul_epu32(t0, p_inv), p);
+        __m256i m1 = _mm256_mul_epu32(_mm256_mul_epu32(t1, p_inv), p);
+        __m256i t = _mm256_blend_epi32(_mm256_srli_epi64(t0, 32), t1, 0xAA);
+        __m256i m = _mm256_blend_epi32(_mm256_srli_epi64(m0, 32), m1, 0xAA);
+        return _mm256_add_epi32(_mm256_sub_epi32(t, m), p);
+    }
+    // x >= q ? x - q : x，x - q 回绕时一定大于 x
+    NTT_AVX2 static __m256i shrink(__m256i x, __m256i q) {
+        return _mm256_min_epu32(x, _mm256_sub_epi32(x, q));
+    }
+    // 一次 8 个蝴蝶，w 为 nullptr 时单位根为 1
+    NTT_AVX2 static void butterfly(__m256i &l, __m256i &r, const __m256i *w) {
+        const __m256i p2 = _mm256_set1_epi32(M::P2);
+        __m256i y = w ? mul(*w, r) : r;
+        r = shrink(_mm256_sub_epi32(_mm256_add_epi32(l, p2), y), p2);
+        l = shrink(_mm256_add_epi32(l, y), p2);
+    }
+    // len 需为 8 的倍数
+    NTT_AVX2 static void block(uint32_t l[], uint32_t r[], const uint32_t w[], size_t len) {
+        for (size_t k = 0; k < len; k += lanes) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(l + k));
+            __m256i y = _mm256_loadu_si256((const __m256i *)(r + k));
+            __m256i wk = _mm256_loadu_si256((const __m256i *)(w + k));
+            butterfly(x, y, &wk);
+            _mm256_storeu_si256((__m256i *)(l + k), x);
+            _mm256_storeu_si256((__m256i *)(r + k), y);
+        }
+    }
+    NTT_AVX2 static void stage(uint32_t a[], size_t n, size_t h, const uint32_t w[]) {
+        if (n < lanes * 2)
+            return Scalar<Mod>::stage(a, n, h, w);
+        if (h >= lanes) {
+            for (size_t j = 0; j < n; j += h * 2)
+                block(a + j, a + j + h, w, h);
+            return;
+        }
+        // 跨度小于 8 的层：每次取 16 个数，重排成左右两半后再做蝴蝶
+        __m256i wk;
+        if (h == 4)
+            wk = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)w));
+        else if (h == 2)
+            wk = _mm256_set_epi32(w[1], w[0], w[1], w[0], w[1], w[0], w[1], w[0]);
+        for (size_t j = 0; j < n; j += lanes * 2) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(a + j));
+            __m256i y = _mm256_loadu_si256((const __m256i *)(a + j + lanes));
+            __m256i l, r;
+            if (h == 4) {
+                l = _mm256_permute2x128_si256(x, y, 0x20);
+                r = _mm256_permute2x128_si256(x, y, 0x31);
+                butterfly(l, r, &wk);
+                x = _mm256_permute2x128_si256(l, r, 0x20);
+                y = _mm256_permute2x128_si256(l, r, 0x31);
+            } else if (h == 2) {
+                l = _mm256_unpacklo_epi64(x, y);
+                r = _mm256_unpackhi_epi64(x, y);
+                butterfly(l, r, &wk);
+                x = _mm256_unpacklo_epi64(l, r);
+                y = _mm256_unpackhi_epi64(l, r);
+            } else {
+                l = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(x),
+                                                          _mm256_castsi256_ps(y), 0x88));
+                r = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(x),
+                                                          _mm256_castsi256_ps(y), 0xDD));
+                butterfly(l, r, nullptr);
+                x = _mm256_unpacklo_epi32(l, r);
+                y = _mm256_unpackhi_epi32(l, r);
+            }
+            _mm256_storeu_si256((__m256i *)(a + j), x);
+            _mm256_storeu_si256((__m256i *)(a + j + lanes), y);
+        }
+    }
+    NTT_AVX2 static void pointwise(uint32_t c[], const uint32_t a[], const uint32_t b[], size_t n) {
+        const __m256i p = _mm256_set1_epi32(M::P), r2 = _mm256_set1_epi32(M::R2);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            __m256i x = mul(_mm256_loadu_si256((const __m256i *)(a + i)),
+                            _mm256_loadu_si256((const __m256i *)(b + i)));
+            _mm256_storeu_si256((__m256i *)(c + i), shrink(mul(x, r2), p));
+        }
+        Scalar<Mod>::pointwise(c + i, a + i, b + i, n - i);
+    }
+    NTT_AVX2 static void scale(uint32_t a[], size_t n, uint32_t s) {
+        const __m256i p = _mm256_set1_epi32(M::P), v = _mm256_set1_epi32(s);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+            _mm256_storeu_si256((__m256i *)(a + i), shrink(mul(x, v), p));
+        }
+        Scalar<Mod>::scale(a + i, n - i, s);
+    }
+    NTT_AVX2 static void reduce(uint32_t a[], size_t n) {
+        const __m256i p = _mm256_set1_epi32(M::P);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+            _mm256_storeu_si256((__m256i *)(a + i), shrink(x, p));
+        }
+        Scalar<Mod>::reduce(a + i, n - i);
+    }
+};
+
+// AVX-512 内核：每次 16 个 32 位 Montgomery 乘法，跨度小于 16 的层交给 AVX2
+// GCC 12 对 avx512fintrin.h 中的 _mm512_set1_epi32 等会误报 -Wmaybe-uninitialized，在这里屏蔽
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+template <uint32_t Mod> struct Avx512 {
+    using M = Montgomery<Mod>;
+    static constexpr size_t lanes = 16;
+
+    NTT_AVX512 static __m512i mul(__m512i a, __m512i b) {
+        const __m512i p = _mm512_set1_epi32(M::P), p_inv = _mm512_set1_epi32(M::P_inv);
+        __m512i t0 = _mm512_mul_epu32(a, b);
+        __m512i t1 = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+        __m512i m0 = _mm512_mul_epu32(_mm512_mul_epu32(t0, p_inv), p);
+        __m512i m1 = _mm512_mul_epu32(_mm512_mul_epu32(t1, p_inv), p);
+        __m512i t = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(t0, 32), t1);
+        __m512i m = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(m0, 32), m1);
+        return _mm512_add_epi32(_mm512_sub_epi32(t, m), p);
+    }
+    NTT_AVX512 static __m512i shrink(__m512i x, __m512i q) {
+        return _mm512_min_epu32(x, _mm512_sub_epi32(x, q));
+    }
+    // len 需为 16 的倍数
+    NTT_AVX512 static void block(uint32_t l[], uint32_t r[], const uint32_t w[], size_t len) {
+        const __m512i p2 = _mm512_set1_epi32(M::P2);
+        for (size_t k = 0; k < len; k += lanes) {
+            __m512i x = _mm512_loadu_si512(l + k);
+            __m512i y = mul(_mm512_loadu_si512(w + k), _mm512_loadu_si512(r + k));
+            _mm512_storeu_si512(l + k, shrink(_mm512_add_epi32(x, y), p2));
+            _mm512_storeu_si512(r + k, shrink(_mm512_sub_epi32(_mm512_add_epi32(x, p2), y), p2));
+        }
+    }
+    NTT_AVX512 static void stage(uint32_t a[], size_t n, size_t h, const uint32_t w[]) {
+        if (h < lanes)
+            return Avx2<Mod>::stage(a, n, h, w);
+        for (size_t j = 0; j < n; j += h * 2)
+            block(a + j, a + j + h, w, h);
+    }
+    NTT_AVX512 static void pointwise(uint32_t c[], const uint32_t a[], const uint32_t b[], size_t n) {
+        const __m512i p = _mm512_set1_epi32(M::P), r2 = _mm512_set1_epi32(M::R2);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            __m512i x = mul(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+            _mm512_storeu_si512(c + i, shrink(mul(x, r2), p));
+        }
+        Scalar<Mod>::pointwise(c + i, a + i, b + i, n - i);
+    }
+    NTT_AVX512 static void scale(uint32_t a[], size_t n, uint32_t s) {
+        const __m512i p = _mm512_set1_epi32(M::P), v = _mm512_set1_epi32(s);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+            _mm512_storeu_si512(a + i, shrink(mul(_mm512_loadu_si512(a + i), v), p));
+        Scalar<Mod>::scale(a + i, n - i, s);
+    }
+    NTT_AVX512 static void reduce(uint32_t a[], size_t n) {
+        const __m512i p = _mm512_set1_epi32(M::P);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+            _mm512_storeu_si512(a + i, shrink(_mm512_loadu_si512(a + i), p));
+        Scalar<Mod>::reduce(a + i, n - i);
+    }
+};
+#pragma GCC diagnostic pop
+#endif
+
+// 线程池：run(n, f) 并行执行 f(0), ..., f(n - 1)，调用者也参与计算
+// 等待时会顺带执行队列中的其他任务，因此任务内部可以再次调用 run
+class ThreadPool {
+  public:
+    static ThreadPool &instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+    ~ThreadPool() { resize(1); }
+    // 线程总数（含调用者），不能在有任务执行时调用
+    void resize(size_t threads) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        ready.notify_all();
+        for (std::thread &t : workers)
+            t.join();
+        workers.clear();
+        stop = false;
+        for (size_t i = 1; i < threads; i++)
+            workers.emplace_back([this] { work(); });
+    }
+    size_t size() const { return workers.size() + 1; }
+    template <class F> void run(size_t n, F f) {
+        if (n == 1 || workers.empty()) {
+            for (size_t i = 0; i < n; i++)
+                f(i);
+            return;
+        }
+        std::atomic<size_t> left(n - 1);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 1; i < n; i++)
+                tasks.emplace_back([&f, &left, i] {
+                    f(i);
+                    left--;
+                });
+        }
+        ready.notify_all();
+        f(0);
+        while (left > 0)
+            if (!help())
+                std::this_thread::yield();
+    }
+
+  private:
+    ThreadPool() = default;
+    // 取出一个任务执行，队列为空时返回 false
+    bool help() {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty())
+                return false;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        return true;
+    }
+    void work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this] { return stop || !tasks.empty(); });
+                if (stop)
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> workers;
+    bool stop = false;
+};
+
+// 变换长度不小于该值时才使用多线程，默认单线程
+size_t PARALLEL_THRESHOLD = 1 << 16;
+// 设置线程数，0 表示使用全部硬件线程
+void set_threads(size_t threads) {
+    ThreadPool::instance().resize(threads ? threads : std::max(1u, std::thread::hardware_concurrency()));
+}
+size_t threads() { return ThreadPool::instance().size(); }
+// 长度为 n 的数据分成几份并行处理：2 的幂，每份不少于 2^12
+size_t parts(size_t n) {
+    if (threads() == 1 || n < PARALLEL_THRESHOLD)
+        return 1;
+    size_t k = 1;
+    while (k < threads() * 4 && n / k >= 1 << 13)
+        k <<= 1;
+    return k;
+}
+
+template <class Kernel> void transform(uint32_t a[], size_t n, int inverse, const Plan &p) {
+    using M = typename Kernel::M;
+    const uint32_t *w = p.w[inverse == -1].data();
+    uint32_t s = M::to(inv(n % M::P, M::P)); // n^{-1} 的 Montgomery 形式
+    size_t k = parts(n), m = n / k, swaps = p.swaps.size() / 2;
+    ThreadPool &pool = ThreadPool::instance();
+    // 位逆序的交换对互不相交，可以任意分组
+    pool.run(k, [&](size_t i) {
+        for (size_t j = swaps * i / k; j < swaps * (i + 1) / k; j++)
+            std::swap(a[p.swaps[j * 2]], a[p.swaps[j * 2 + 1]]);
+    });
+    // 跨度小于 m 的层只在各自的一段内进行，每份连续做完这些层
+    pool.run(k, [&](size_t i) {
+        for (size_t h = 1; h < m; h <<= 1)
+            Kernel::stage(a + i * m, m, h, w + h);
+    });
+    // 更大跨度的层每层同步一次，每份负责同一组里连续的 m / 2 个蝴蝶
+    for (size_t h = m; h < n; h <<= 1)
+        pool.run(k, [&](size_t i) {
+            size_t j = i * (m / 2) / h * h * 2, o = i * (m / 2) % h;
+            Kernel::block(a + j + o, a + j + h + o, w + h + o, m / 2);
+        });
+    pool.run(k, [&](size_t i) {
+        if (inverse == -1)
+            Kernel::scale(a + i * m, m, s);
+        else
+            Kernel::reduce(a + i * m, m);
+    });
+}
+
+// 单模数 NTT，inverse 为 1 时正变换，为 -1 时逆变换
+// 输入在 [0, 2P) 内，输出在 [0, P) 内
+template <uint32_t Mod> void transform(uint32_t a[], size_t n, int inverse) {
+    std::shared_ptr<const Plan> p = plan(Mod, n);
+    switch (active_isa()) {
+#ifdef NTT_SIMD
+    case Isa::avx512:
+        return transform<Avx512<Mod>>(a, n, inverse, *p);
+    case Isa::avx2:
+        return transform<Avx2<Mod>>(a, n, inverse, *p);
+#endif
+    default:
+        return transform<Scalar<Mod>>(a, n, inverse, *p);
+    }
+}
+// 逐点乘积 c[i] = a[i] * b[i] mod P，c 可以与 a 相同，输入在 [0, 2P) 内，输出在 [0, P) 内
+template <uint32_t Mod>
+void pointwise(uint32_t c[], const uint32_t a[], const uint32_t b[], size_t n) {
+    size_t k = parts(n);
+    ThreadPool::instance().run(k, [&](size_t i) {
+        size_t lo = n * i / k, len = n * (i + 1) / k - lo;
+        switch (active_isa()) {
+#ifdef NTT_SIMD
+        case Isa::avx512:
+            return Avx512<Mod>::pointwise(c + lo, a + lo, b + lo, len);
+        case Isa::avx2:
+            return Avx2<Mod>::pointwise(c + lo, a + lo, b + lo, len);
+#endif
+        default:
+            return Scalar<Mod>::pointwise(c + lo, a + lo, b + lo, len);
+        }
+    });
+}
+// 大整数类以 int 保存系数，值非负，可以直接按 uint32_t 访问
+template <uint32_t Mod> void transform(int a[], size_t n, int inverse) {
+    transform<Mod>(reinterpret_cast<uint32_t *>(a), n, inverse);
+}
+template <uint32_t Mod> void pointwise(int c[], const int a[], const int b[], size_t n) {
+    pointwise<Mod>(reinterpret_cast<uint32_t *>(c), reinterpret_cast<const uint32_t *>(a),
+                   reinterpret_cast<const uint32_t *>(b), n);
+}
+
 struct CRT {
     int A = 0, B = 0;
     CRT() {}
@@ -20,7 +608,7 @@ struct CRT {
     friend CRT operator+(const CRT &a, const CRT &b) { return CRT(a.A + b.A - P1, a.B + b.B - P2); }
     friend CRT operator-(const CRT &a, const CRT &b) { return CRT(a.A - b.A, a.B - b.B); }
     friend CRT operator*(const CRT &a, const CRT &b) {
-        return CRT(1LL * a.A * b.A % P1, 1LL * a.B * b.B % P2);
+        return CRT(Montgomery<P1>::mul_exact(a.A, b.A), Montgomery<P2>::mul_exact(a.B, b.B));
     }
     long long get() {
         long long x1 = A;
@@ -28,29 +616,378 @@ struct CRT {
         return x2;
     }
 };
+// 两个模数分别做变换
 void NTT(CRT a[], size_t n, int inverse) {
-    std::vector<size_t> rev(n);
-    for (size_t i = 0; i < n; i++) {
-        rev[i] = (rev[i >> 1] >> 1) | ((i & 1) << std::__lg(n >> 1));
-        if (i < rev[i])
-            std::swap(a[i], a[rev[i]]);
-    }
-    for (size_t i = 2; i <= n; i <<= 1) {
-        CRT gn = CRT(ksm(inverse == 1 ? G : inv(G, P1), (P1 - 1) / i, P1),
-                     ksm(inverse == 1 ? G : inv(G, P2), (P2 - 1) / i, P2));
-        for (size_t j = 0; j < n; j += i) {
-            CRT g0 = 1;
-            for (size_t k = j; k < j + i / 2; ++k, g0 = g0 * gn) {
-                CRT x = a[k], y = g0 * a[k + i / 2];
-                a[k] = x + y;
-                a[k + i / 2] = x - y;
-            }
+    Memory::vector<uint32_t> A(n), B(n);
+    for (size_t i = 0; i < n; i++)
+        A[i] = a[i].A, B[i] = a[i].B;
+    transform<P1>(A.data(), n, inverse);
+    transform<P2>(B.data(), n, inverse);
+    for (size_t i = 0; i < n; i++)
+        a[i].A = A[i], a[i].B = B[i];
+}
+
+// 三模数 NTT 乘法，Garner 算法重建出精确的卷积系数后直接进位
+// 三个模数都小于 2^30，乘积约 5.9e25；最大变换长度受 M3 限制为 2^24
+const uint32_t M1 = 469762049, M2 = 167772161, M3 = 754974721;
+const size_t MAX_LENGTH = 1 << 24;
+
+// 128 位整数除以编译期常量 D，返回余数；t 的高 64 位需小于 2^32
+template <uint32_t D> uint32_t divmod(unsigned __int128 &t) {
+    uint64_t hi = uint64_t(t >> 64), lo = uint64_t(t);
+    uint64_t r = (hi << 32) | (lo >> 32);
+    uint64_t q1 = r / D;
+    r = ((r % D) << 32) | uint32_t(lo);
+    uint64_t q0 = r / D;
+    t = (unsigned __int128)(q1 >> 32) << 64 | (q1 << 32 | q0);
+    return r % D;
+}
+
+// Garner 算法用到的常数，均为 Montgomery 形式
+const uint32_t GARNER_INV1 = Montgomery<M2>::to(inv(M1 % M2, M2));
+const uint32_t GARNER_INV12 = Montgomery<M3>::to(inv(1ULL * M1 * M2 % M3, M3));
+const uint32_t GARNER_M1 = Montgomery<M3>::to(M1 % M3);
+
+// 三个模数下的卷积结果，operator[] 按 Garner 算法重建出精确的卷积系数
+struct Convolution {
+    const uint32_t *r1, *r2, *r3;
+    unsigned __int128 operator[](size_t i) const {
+        uint32_t x1 = r1[i];
+        uint32_t x2 = Montgomery<M2>::shrink(Montgomery<M2>::mul(r2[i] + M2 - x1 % M2, GARNER_INV1));
+        uint32_t x3 = r3[i] + M3 * 2 - x1 % M3 - Montgomery<M3>::shrink(Montgomery<M3>::mul(x2, GARNER_M1));
+        x3 = Montgomery<M3>::shrink(Montgomery<M3>::mul(x3, GARNER_INV12));
+        return x1 + (unsigned __int128)M1 * (x2 + (unsigned __int128)M2 * x3);
+    }
+};
+
+// a * b 的卷积，要求 min(al, bl) * max(a) * max(b) < M1 * M2 * M3
+// a 与 b 相同时按平方计算，每个模数只做一次正变换
+// 多线程时三个模数、两个乘数的正变换都并行进行，结果与单线程完全相同
+// 结果与变换用的空间都从 ws 中取用，由调用方在用完结果后归还
+Convolution convolve(const uint32_t a[], size_t al, const uint32_t b[], size_t bl,
+                     Memory::Workspace &ws = Memory::workspace()) {
+    size_t len = 2 << std::__lg(al + bl - 1);
+    assert(len <= MAX_LENGTH);
+    BIG_STATS_TRANSFORM(len);
+    bool same = a == b && al == bl, parallel = parts(len) > 1;
+    // 工作区不能在线程间共用，各线程要用的空间先在这里取好
+    uint32_t *x[3], *y[3];
+    for (int i = 0; i < 3; i++)
+        x[i] = ws.take<uint32_t>(len), y[i] = ws.take<uint32_t>(same ? 0 : len);
+    auto each = [&](size_t n, auto f) {
+        if (parallel)
+            ThreadPool::instance().run(n, f);
+        else
+            for (size_t i = 0; i < n; i++)
+                f(i);
+    };
+    auto run = [&](uint32_t x[], uint32_t t[], auto mod) {
+        constexpr uint32_t Mod = decltype(mod)::value;
+        std::fill(std::copy(a, a + al, x), x + len, 0);
+        if (!same)
+            std::fill(std::copy(b, b + bl, t), t + len, 0);
+        each(same ? 1 : 2, [&](size_t i) { transform<Mod>(i ? t : x, len, 1); });
+        pointwise<Mod>(x, x, same ? x : t, len);
+        transform<Mod>(x, len, -1);
+    };
+    each(3, [&](size_t i) {
+        if (i == 0)
+            run(x[0], y[0], std::integral_constant<uint32_t, M1>());
+        else if (i == 1)
+            run(x[1], y[1], std::integral_constant<uint32_t, M2>());
+        else
+            run(x[2], y[2], std::integral_constant<uint32_t, M3>());
+    });
+    return Convolution{x[0], x[1], x[2]};
+}
+
+void multiply64(const int a[], size_t al, const int b[], size_t bl, int c[], Memory::Workspace &ws);
+
+// c[0, al + bl) = a * b，a、b、c 均为 10^4 进制的小端数组，c 可以与 a 或 b 相同
+// 每两位压成一个 10^8 进制的系数参与变换，两个乘数分别压成 (al + 1) / 2 与 (bl + 1) / 2 个系数，
+// 所需的变换长度超过 MAX_LENGTH 时改用 multiply64
+void multiply(const int a[], size_t al, const int b[], size_t bl, int c[],
+              Memory::Workspace &ws = Memory::workspace()) {
+    if (al == 0 || bl == 0) {
+        std::fill(c, c + al + bl, 0);
+        return;
+    }
+    size_t Al = (al + 1) / 2, Bl = (bl + 1) / 2;
+    // 与 convolve 中的变换长度相同
+    if ((size_t(2) << std::__lg(Al + Bl - 1)) > MAX_LENGTH)
+        return multiply64(a, al, b, bl, c, ws);
+    BIG_STATS_ALGORITHM(big_stats::ntt);
+    Memory::Workspace::Frame frame(ws);
+    auto pack = [&](const int x[], size_t l) {
+        uint32_t *y = ws.take<uint32_t>((l + 1) / 2);
+        for (size_t i = 0; i < l; i++)
+            y[i / 2] = i % 2 ? y[i / 2] + x[i] * 10000 : x[i];
+        return y;
+    };
+    bool same = a == b && al == bl;
+    const uint32_t *A = pack(a, al), *B = same ? A : pack(b, bl);
+    Convolution conv = convolve(A, Al, B, Bl, ws);
+    // 第 j 个 10^8 进制位对应 c[2j] 和 c[2j + 1]（若存在）
+    size_t n = (al + bl + 1) / 2, k = parts(n);
+    auto put = [&](size_t j, uint32_t digit) {
+        c[j * 2] = digit % 10000;
+        if (j * 2 + 1 < al + bl)
+            c[j * 2 + 1] = digit / 10000;
+    };
+    auto get = [&](size_t j) { return c[j * 2] + (j * 2 + 1 < al + bl ? c[j * 2 + 1] * 10000 : 0); };
+    // 分成 k 份各自进位，再把每份剩下的进位依次加到下一份上
+    BIG_STATS_SCOPE(big_stats::carry, n);
+    unsigned __int128 *out = ws.take<unsigned __int128>(k);
+    ThreadPool::instance().run(k, [&](size_t i) {
+        unsigned __int128 carry = 0;
+        for (size_t j = n * i / k; j < n * (i + 1) / k; j++) {
+            carry += conv[j];
+            put(j, divmod<100000000>(carry));
+        }
+        out[i] = carry;
+    });
+    unsigned __int128 carry = 0;
+    for (size_t i = 0; i < k; i++) {
+        for (size_t j = n * i / k; carry && j < n * (i + 1) / k; j++) {
+            carry += get(j);
+            put(j, divmod<100000000>(carry));
         }
+        carry += out[i];
+    }
+    assert(carry == 0);
+}
+
+// c[0, al * 2) = a * a
+void square(const int a[], size_t al, int c[], Memory::Workspace &ws = Memory::workspace()) {
+    multiply(a, al, a, al, c, ws);
+}
+
+// 超过三模数最大长度时使用的 64 位 NTT，模数 p = 2^64 - 2^32 + 1，原根 7
+// p - 1 含因子 2^32，变换长度最多 2^32；系数直接用 10^4 进制，卷积系数不超过
+// min(al, bl) * 9999^2，在 al + bl <= 2^32 时远小于 p，结果总是精确的
+struct Goldilocks {
+    static constexpr uint64_t P = 0xFFFFFFFF00000001ULL, EPS = 0xFFFFFFFFULL;
+    static uint64_t add(uint64_t a, uint64_t b) {
+        uint64_t c = P - b;
+        return a >= c ? a - c : a + b;
+    }
+    static uint64_t sub(uint64_t a, uint64_t b) { return a < b ? a + (P - b) : a - b; }
+    // 2^64 ≡ 2^32 - 1，2^96 ≡ -1 (mod p)
+    static uint64_t mul(uint64_t a, uint64_t b) {
+        unsigned __int128 x = (unsigned __int128)a * b;
+        uint64_t lo = uint64_t(x), hi = uint64_t(x >> 64), t, r;
+        bool borrow = __builtin_sub_overflow(lo, hi >> 32, &t);
+        t -= EPS * borrow;
+        bool carry = __builtin_add_overflow(t, (hi & EPS) * EPS, &r);
+        r += EPS * carry;
+        return r >= P ? r - P : r;
+    }
+    static uint64_t pow(uint64_t a, uint64_t b) {
+        uint64_t s = 1;
+        for (; b; b >>= 1, a = mul(a, a))
+            if (b & 1)
+                s = mul(s, a);
+        return s;
+    }
+};
+const size_t MAX_LENGTH_64 = size_t(1) << 32;
+
+// 64 位 NTT，inverse 为 1 时正变换，为 -1 时逆变换，输入输出均在 [0, p) 内
+// 只保存最长一层的单位根 w[k] = ω_n^k，跨度为 h 的层先按步长 n / 2h 取出连续的一份
+// 逆变换等于正变换后把 a[1, n) 反转，再乘以 n^{-1}
+void transform64(uint64_t a[], size_t n, int inverse) {
+    using G = Goldilocks;
+    assert(n <= MAX_LENGTH_64);
+    if (n == 1)
+        return;
+    size_t k = parts(n), m = n / k, lg = std::__lg(n);
+    ThreadPool &pool = ThreadPool::instance();
+    Memory::vector<uint64_t> w(n / 2);
+    uint64_t root = G::pow(7, (G::P - 1) >> lg);
+    pool.run(k, [&](size_t i) {
+        size_t lo = n / 2 * i / k, hi = n / 2 * (i + 1) / k;
+        uint64_t x = G::pow(root, lo);
+        for (size_t j = lo; j < hi; j++, x = G::mul(x, root))
+            w[j] = x;
+    });
+    // 位逆序：每份从 rev(lo) 开始逐个递增
+    pool.run(k, [&](size_t i) {
+        size_t lo = i * m, j = 0;
+        for (size_t b = 0; b < lg; b++)
+            j |= (lo >> b & 1) << (lg - 1 - b);
+        for (size_t x = lo; x < lo + m; x++) {
+            if (x < j)
+                std::swap(a[x], a[j]);
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+        }
+    });
+    auto block = [](uint64_t l[], uint64_t r[], const uint64_t wh[], size_t len) {
+        for (size_t j = 0; j < len; j++) {
+            uint64_t x = l[j], y = G::mul(wh[j], r[j]);
+            l[j] = G::add(x, y);
+            r[j] = G::sub(x, y);
+        }
+    };
+    // 跨度为 h 的层的单位根：最后一层直接用 w，其余各层在 ws[h, 2h)
+    Memory::vector<uint64_t> ws(std::min(m, n / 2));
+    for (size_t h = 1; h < ws.size(); h <<= 1)
+        for (size_t j = 0; j < h; j++)
+            ws[h + j] = w[j * (n / (h * 2))];
+    auto twiddles = [&](size_t h) { return h == n / 2 ? w.data() : ws.data() + h; };
+    // 跨度小于 m 的层只在各自的一段内进行，每份连续做完这些层
+    pool.run(k, [&](size_t i) {
+        for (size_t h = 1; h < m; h <<= 1)
+            for (size_t j = i * m; j < (i + 1) * m; j += h * 2)
+                block(a + j, a + j + h, twiddles(h), h);
+    });
+    for (size_t h = m; h < n; h <<= 1) {
+        Memory::vector<uint64_t> wide(h == n / 2 ? 0 : h);
+        for (size_t j = 0; j < wide.size(); j++)
+            wide[j] = w[j * (n / (h * 2))];
+        const uint64_t *wh = wide.empty() ? w.data() : wide.data();
+        pool.run(k, [&](size_t i) {
+            size_t j = i * (m / 2) / h * h * 2, o = i * (m / 2) % h;
+            block(a + j + o, a + j + h + o, wh + o, m / 2);
+        });
     }
     if (inverse == -1) {
-        const CRT n_inv(inv(n, P1), inv(n, P2));
-        for (size_t i = 0; i < n; i++)
-            a[i] = a[i] * n_inv;
+        std::reverse(a + 1, a + n);
+        uint64_t s = G::pow(n, G::P - 2);
+        pool.run(k, [&](size_t i) {
+            for (size_t j = i * m; j < (i + 1) * m; j++)
+                a[j] = G::mul(a[j], s);
+        });
+    }
+}
+
+// a * b 的精确卷积，结果放在长度为 2 的幂的数组中，有效部分为前 al + bl - 1 项
+// 要求 min(al, bl) * max(a) * max(b) < p 且 al + bl <= 2^32
+// 结果从 ws 中取用，由调用方在用完后归还
+template <class T>
+uint64_t *convolve64(const T a[], size_t al, const T b[], size_t bl, Memory::Workspace &ws = Memory::workspace()) {
+    using G = Goldilocks;
+    size_t len = 2 << std::__lg(al + bl - 1);
+    assert(len <= MAX_LENGTH_64);
+    BIG_STATS_TRANSFORM(len);
+    bool same = a == b && al == bl;
+    uint64_t *x = ws.take<uint64_t>(len), *y = ws.take<uint64_t>(same ? 0 : len);
+    std::fill(std::copy(a, a + al, x), x + len, 0);
+    if (!same)
+        std::fill(std::copy(b, b + bl, y), y + len, 0);
+    transform64(x, len, 1);
+    if (!same)
+        transform64(y, len, 1);
+    size_t k = parts(len);
+    ThreadPool::instance().run(k, [&](size_t i) {
+        for (size_t j = len * i / k; j < len * (i + 1) / k; j++)
+            x[j] = G::mul(x[j], same ? x[j] : y[j]);
+    });
+    transform64(x, len, -1);
+    return x;
+}
+
+// c[0, al + bl) = a * b，用于三模数 NTT 的变换长度超过 MAX_LENGTH 的情形，最多支持 al + bl <= 2^32
+// 每个系数一个 10^4 进制位，内存约为 20 * len 字节（len 为不小于 al + bl 的 2 的幂）
+void multiply64(const int a[], size_t al, const int b[], size_t bl, int c[], Memory::Workspace &ws) {
+    BIG_STATS_ALGORITHM(big_stats::ntt64);
+    Memory::Workspace::Frame frame(ws);
+    const uint64_t *x = convolve64(a, al, b, bl, ws);
+    // 卷积系数不超过 2^32 * 10^8，加上进位仍在 uint64_t 范围内
+    size_t n = al + bl, k = parts(n);
+    BIG_STATS_SCOPE(big_stats::carry, n);
+    uint64_t *out = ws.take<uint64_t>(k);
+    ThreadPool::instance().run(k, [&](size_t i) {
+        uint64_t carry = 0;
+        for (size_t j = n * i / k; j < n * (i + 1) / k; j++) {
+            carry += x[j];
+            c[j] = carry % 10000;
+            carry /= 10000;
+        }
+        out[i] = carry;
+    });
+    uint64_t carry = 0;
+    for (size_t i = 0; i < k; i++) {
+        for (size_t j = n * i / k; carry && j < n * (i + 1) / k; j++) {
+            carry += c[j];
+            c[j] = carry % 10000;
+            carry /= 10000;
+        }
+        carry += out[i];
+    }
+    assert(carry == 0);
+}
+
+// c[0, al + bl) = a * b，a、b、c 均为 2^32 进制的小端数组，c 可以与 a 或 b 相同
+// 把比特流按 W 位切成系数参与变换，进位只需移位：三模数 NTT 取 W = 24，
+// 卷积系数不超过 2^72；超出其最大长度时改用 64 位 NTT，取 W = 16 以保证系数小于 p
+void multiply(const uint32_t a[], size_t al, const uint32_t b[], size_t bl, uint32_t c[],
+              Memory::Workspace &ws = Memory::workspace()) {
+    if (al == 0 || bl == 0) {
+        std::fill(c, c + al + bl, 0);
+        return;
     }
+    Memory::Workspace::Frame frame(ws);
+    bool same = a == b && al == bl;
+    size_t n = al + bl;
+    // 每 L 个 32 位恰好是 K 个 W 位系数
+    auto run = [&](auto width, auto convolve) {
+        constexpr size_t W = decltype(width)::value, K = 32 / std::gcd<size_t>(W, 32), L = W * K / 32;
+        auto split = [&](const uint32_t x[], size_t l) {
+            uint32_t *y = ws.take<uint32_t>((l * 32 + W - 1) / W);
+            for (size_t j = 0; j < (l * 32 + W - 1) / W; j++) {
+                size_t w = j * W / 32, off = j * W % 32;
+                uint64_t v = x[w] >> off;
+                if (w + 1 < l)
+                    v |= uint64_t(x[w + 1]) << (32 - off);
+                y[j] = uint32_t(v) & ((1u << W) - 1);
+            }
+            return y;
+        };
+        size_t Al = (al * 32 + W - 1) / W, Bl = (bl * 32 + W - 1) / W;
+        const uint32_t *A = split(a, al), *B = same ? A : split(b, bl);
+        size_t m = Al + Bl - 1, groups = (n + L - 1) / L, k = parts(groups);
+        auto conv = convolve(A, Al, B, Bl);
+        // 与 10^4 进制相同，分段各自进位后再依次传递每段剩下的进位
+        BIG_STATS_SCOPE(big_stats::carry, n);
+        unsigned __int128 *out = ws.take<unsigned __int128>(k);
+        ThreadPool::instance().run(k, [&](size_t i) {
+            unsigned __int128 carry = 0;
+            for (size_t g = groups * i / k; g < groups * (i + 1) / k; g++) {
+                unsigned __int128 bits = 0;
+                for (size_t t = 0; t < K; t++) {
+                    if (g * K + t < m)
+                        carry += conv[g * K + t];
+                    bits |= (carry & ((1u << W) - 1)) << (W * t);
+                    carry >>= W;
+                }
+                for (size_t t = 0; t < L && g * L + t < n; t++)
+                    c[g * L + t] = uint32_t(bits >> (32 * t));
+            }
+            out[i] = carry;
+        });
+        unsigned __int128 carry = 0;
+        for (size_t i = 0; i < k; i++) {
+            for (size_t j = std::min(n, groups * i / k * L); carry && j < std::min(n, groups * (i + 1) / k * L); j++) {
+                carry += c[j];
+                c[j] = uint32_t(carry);
+                carry >>= 32;
+            }
+            carry += out[i];
+        }
+        assert(carry == 0);
+    };
+    // 两个乘数各自切分，按切分后的实际长度判断三模数 NTT 的变换长度是否超出
+    size_t Al = (al * 32 + 23) / 24, Bl = (bl * 32 + 23) / 24;
+    bool fits = (size_t(2) << std::__lg(Al + Bl - 1)) <= MAX_LENGTH;
+    BIG_STATS_ALGORITHM(fits ? big_stats::ntt : big_stats::ntt64);
+    if (fits)
+        run(std::integral_constant<size_t, 24>(),
+            [&](auto... args) { return NTT::convolve(args..., ws); });
+    else
+        run(std::integral_constant<size_t, 16>(),
+            [&](auto... args) { return convolve64(args..., ws); });
 }
-} // namespace NTT
\ No newline at end of file
+} // namespace NTT
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+// 大整数与单个机器字（不超过 2^63）的运算，Base 进制（10^K 或 2^32）的小端数组上一趟完成
+// x 不超过 2^64 / Base 时中间结果用 64 位整数，否则用 128 位整数
+namespace Scalar {
+// a[0, n) *= x，返回溢出到高位的部分（小于 x）
+template <class Limb, uint64_t Base> uint64_t mul_1(Limb a[], size_t n, uint64_t x) {
+    if (x <= UINT64_MAX / Base) {
+        uint64_t c = 0;
+        for (size_t i = 0; i < n; i++) {
+            c += uint64_t(a[i]) * x;
+            a[i] = Limb(c % Base);
+            c /= Base;
+        }
+        return c;
+    }
+    unsigned __int128 c = 0;
+    for (size_t i = 0; i < n; i++) {
+        c += (unsigned __int128)a[i] * x;
+        a[i] = Limb(c % Base);
+        c /= Base;
+    }
+    return uint64_t(c);
+}
+// a[0, n) /= x，返回余数，x 不能为 0
+template <class Limb, uint64_t Base> uint64_t div_1(Limb a[], size_t n, uint64_t x) {
+    assert(x);
+    if (x <= UINT64_MAX / Base) {
+        uint64_t r = 0;
+        for (size_t i = n; i-- > 0;) {
+            r = r * Base + a[i];
+            a[i] = Limb(r / x);
+            r %= x;
+        }
+        return r;
+    }
+    unsigned __int128 r = 0;
+    for (size_t i = n; i-- > 0;) {
+        r = r * Base + a[i];
+        a[i] = Limb(r / x);
+        r %= x;
+    }
+    return uint64_t(r);
+}
+// a[0, n) 除以 x 的余数，不修改 a
+template <class Limb, uint64_t Base> uint64_t mod_1(const Limb a[], size_t n, uint64_t x) {
+    assert(x);
+    if (x <= UINT64_MAX / Base) {
+        uint64_t r = 0;
+        for (size_t i = n; i-- > 0;)
+            r = (r * Base + a[i]) % x;
+        return r;
+    }
+    unsigned __int128 r = 0;
+    for (size_t i = n; i-- > 0;)
+        r = (r * Base + a[i]) % x;
+    return uint64_t(r);
+}
+// a[0, n) += x，返回进到第 n 位及以上的部分
+template <class Limb, uint64_t Base> uint64_t add_1(Limb a[], size_t n, uint64_t x) {
+    for (size_t i = 0; i < n && x; i++) {
+        uint64_t lo = x % Base;
+        x /= Base;
+        if (uint64_t(a[i]) + lo >= Base)
+            a[i] = Limb(uint64_t(a[i]) + lo - Base), x++;
+        else
+            a[i] = Limb(uint64_t(a[i]) + lo);
+    }
+    return x;
+}
+// a[0, n) -= x，要求 a >= x
+template <class Limb, uint64_t Base> void sub_1(Limb a[], size_t n, uint64_t x) {
+    for (size_t i = 0; i < n && x; i++) {
+        uint64_t lo = x % Base;
+        x /= Base;
+        if (uint64_t(a[i]) < lo)
+            a[i] = Limb(uint64_t(a[i]) + Base - lo), x++;
+        else
+            a[i] = Limb(uint64_t(a[i]) - lo);
+    }
+    assert(x == 0);
+}
+// 比较 a[0, n) 与 x，要求 a 没有前导零
+template <class Limb, uint64_t Base> int cmp_1(const Limb a[], size_t n, uint64_t x) {
+    Limb t[64];
+    size_t k = 0;
+    for (; x; x /= Base)
+        t[k++] = Limb(x % Base);
+    if (n != k)
+        return n < k ? -1 : 1;
+    for (size_t i = n; i-- > 0;)
+        if (a[i] != t[i])
+            return a[i] < t[i] ? -1 : 1;
+    return 0;
+}
+// a[0, n) 的值，要求不超过 2^64 - 1
+template <class Limb, uint64_t Base> uint64_t value(const Limb a[], size_t n) {
+    uint64_t v = 0;
+    for (size_t i = n; i-- > 0;)
+        v = v * Base + a[i];
+    return v;
+}
+} // namespace Scalar
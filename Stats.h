@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+// 为 1 时统计各项运算的次数、位数分布、耗时，乘法所用的算法、NTT 的长度与申请的内存
+// 默认为 0，此时 BIG_STATS_* 宏都展开为空，没有任何开销；snapshot() 仍可调用，结果全为 0
+#ifndef BIG_STATS
+#define BIG_STATS 0
+#endif
+
+namespace big_stats {
+// carry 为乘法最后统一进位的部分，同时计入外层的 mul 或 square
+enum Op { add, sub, mul, square, div, parse, print, carry, OPS };
+const char *const OP_NAMES[OPS] = {"add", "sub", "mul", "square", "div", "parse", "print", "carry"};
+// 乘法顶层所用的算法，ntt64 为超出三模数长度时的 64 位 NTT
+enum Algorithm { schoolbook, karatsuba, toom3, ntt, ntt64, ALGORITHMS };
+const char *const ALGORITHM_NAMES[ALGORITHMS] = {"schoolbook", "karatsuba", "toom3", "ntt", "ntt64"};
+// 位数与变换长度按 2 的幂分组：第 k 组为 [2^k, 2^(k+1))，第 0 组也包含 0
+const int BUCKETS = 48;
+int bucket(size_t n) { return n < 2 ? 0 : std::min<int>(std::__lg(n), BUCKETS - 1); }
+
+// 时间戳：x86 上为 rdtsc 的周期数，其他平台为纳秒
+uint64_t cycles() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+struct OpStats {
+    size_t calls;          // 调用次数
+    size_t limbs;          // 较长操作数的位数之和
+    size_t cycles;         // 累计耗时
+    size_t sizes[BUCKETS]; // 较长操作数位数的分布
+};
+struct Snapshot {
+    OpStats ops[OPS];
+    size_t algorithms[ALGORITHMS];
+    size_t transforms[BUCKETS]; // 每次卷积的变换长度（2 的幂）的分布
+    size_t allocations;         // 经 Memory::allocate 申请的次数
+    size_t bytes_allocated;     // 以及申请的字节数
+    std::string text() const;
+    std::string json() const;
+};
+
+// 计数器，多线程时各线程都累加到这里
+struct Counter {
+    std::atomic<size_t> calls, limbs, cycles, sizes[BUCKETS];
+};
+Counter counters[OPS];
+std::atomic<size_t> algorithms[ALGORITHMS], transforms[BUCKETS], allocations, bytes_allocated;
+
+void record(Op op, size_t limbs, uint64_t elapsed) {
+    Counter &c = counters[op];
+    c.calls.fetch_add(1, std::memory_order_relaxed);
+    c.limbs.fetch_add(limbs, std::memory_order_relaxed);
+    c.cycles.fetch_add(elapsed, std::memory_order_relaxed);
+    c.sizes[bucket(limbs)].fetch_add(1, std::memory_order_relaxed);
+}
+void choose(Algorithm a) { algorithms[a].fetch_add(1, std::memory_order_relaxed); }
+void transform(size_t len) { transforms[bucket(len)].fetch_add(1, std::memory_order_relaxed); }
+void allocate(size_t bytes) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// 记录一次运算，从构造到析构计时；同一线程中嵌套的同种运算（如乘法内部的递归）只记最外层
+thread_local int depth[OPS];
+class Scope {
+  public:
+    Scope(Op op, size_t limbs) : op(op), limbs(limbs), outer(depth[op]++ == 0), start(outer ? cycles() : 0) {}
+    Scope(const Scope &) = delete;
+    ~Scope() {
+        depth[op]--;
+        if (outer)
+            record(op, limbs, cycles() - start);
+    }
+
+  private:
+    Op op;
+    size_t limbs;
+    bool outer;
+    uint64_t start;
+};
+
+Snapshot snapshot() {
+    Snapshot s{};
+    for (int i = 0; i < OPS; i++) {
+        s.ops[i].calls = counters[i].calls.load();
+        s.ops[i].limbs = counters[i].limbs.load();
+        s.ops[i].cycles = counters[i].cycles.load();
+        for (int k = 0; k < BUCKETS; k++)
+            s.ops[i].sizes[k] = counters[i].sizes[k].load();
+    }
+    for (int i = 0; i < ALGORITHMS; i++)
+        s.algorithms[i] = algorithms[i].load();
+    for (int k = 0; k < BUCKETS; k++)
+        s.transforms[k] = transforms[k].load();
+    s.allocations = allocations.load();
+    s.bytes_allocated = bytes_allocated.load();
+    return s;
+}
+// 清零全部计数，应在没有运算进行时调用
+void reset() {
+    for (Counter &c : counters) {
+        c.calls = c.limbs = c.cycles = 0;
+        for (auto &x : c.sizes)
+            x = 0;
+    }
+    for (auto &x : algorithms)
+        x = 0;
+    for (auto &x : transforms)
+        x = 0;
+    allocations = bytes_allocated = 0;
+}
+
+// 分布写成 "2^k:次数" 或 JSON 的 {"2^k": 次数}，只列出非零的组
+std::string histogram(const size_t h[], bool json) {
+    std::string s;
+    for (int k = 0; k < BUCKETS; k++)
+        if (h[k]) {
+            if (!s.empty())
+                s += json ? ", " : " ";
+            s += (json ? "\"2^" : "2^") + std::to_string(k) + (json ? "\": " : ":") + std::to_string(h[k]);
+        }
+    return json ? "{" + s + "}" : s;
+}
+std::string Snapshot::text() const {
+    std::string s = "op          calls          limbs         cycles   cycles/call  sizes (2^k:calls)\n";
+    for (int i = 0; i < OPS; i++) {
+        const OpStats &o = ops[i];
+        if (!o.calls)
+            continue;
+        char line[128];
+        std::snprintf(line, sizeof line, "%-8s %8zu %14zu %14zu %13.0f  ", OP_NAMES[i], o.calls, o.limbs, o.cycles,
+                      double(o.cycles) / o.calls);
+        s += line + histogram(o.sizes, false) + "\n";
+    }
+    s += "algorithms:";
+    for (int i = 0; i < ALGORITHMS; i++)
+        s += " " + std::string(ALGORITHM_NAMES[i]) + ":" + std::to_string(algorithms[i]);
+    s += "\ntransforms: " + histogram(transforms, false) + "\n";
+    s += "allocations: " + std::to_string(allocations) + " (" + std::to_string(bytes_allocated) + " bytes)\n";
+    return s;
+}
+std::string Snapshot::json() const {
+    std::string s = "{\"ops\": {";
+    for (int i = 0; i < OPS; i++) {
+        const OpStats &o = ops[i];
+        s += std::string(i ? ", " : "") + "\"" + OP_NAMES[i] + "\": {\"calls\": " + std::to_string(o.calls) +
+             ", \"limbs\": " + std::to_string(o.limbs) + ", \"cycles\": " + std::to_string(o.cycles) +
+             ", \"sizes\": " + histogram(o.sizes, true) + "}";
+    }
+    s += "}, \"algorithms\": {";
+    for (int i = 0; i < ALGORITHMS; i++)
+        s += std::string(i ? ", " : "") + "\"" + ALGORITHM_NAMES[i] + "\": " + std::to_string(algorithms[i]);
+    s += "}, \"transforms\": " + histogram(transforms, true);
+    s += ", \"allocations\": " + std::to_string(allocations) +
+         ", \"bytes_allocated\": " + std::to_string(bytes_allocated) + "}";
+    return s;
+}
+} // namespace big_stats
+
+#if BIG_STATS
+// 同一函数中可以有多个 Scope，变量名带上行号
+#define BIG_STATS_CONCAT2(a, b) a##b
+#define BIG_STATS_CONCAT(a, b) BIG_STATS_CONCAT2(a, b)
+#define BIG_STATS_SCOPE(op, limbs) big_stats::Scope BIG_STATS_CONCAT(big_stats_scope, __LINE__)(op, limbs)
+#define BIG_STATS_ALGORITHM(a) big_stats::choose(a)
+#define BIG_STATS_TRANSFORM(len) big_stats::transform(len)
+#define BIG_STATS_ALLOCATE(bytes) big_stats::allocate(bytes)
+#else
+#define BIG_STATS_SCOPE(op, limbs) ((void)0)
+#define BIG_STATS_ALGORITHM(a) ((void)0)
+#define BIG_STATS_TRANSFORM(len) ((void)0)
+#define BIG_STATS_ALLOCATE(bytes) ((void)0)
+#endif
@@ -0,0 +1,120 @@
+#include "Multiply.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 在本机测量各层乘法的交叉点，打印对照表并生成 MultiplyConfig.h
+// 用法：./tune [输出文件，默认 MultiplyConfig.h]
+
+std::mt19937 gen(20240601);
+
+// 两个 n 位随机数相乘的耗时（微秒），取三轮中最快的一轮
+double measure(size_t n) {
+    std::vector<int> a(n), b(n), c(n * 2);
+    for (auto &x : a)
+        x = gen() % 10000;
+    for (auto &x : b)
+        x = gen() % 10000;
+    a[n - 1] = b[n - 1] = 9999;
+    using clock = std::chrono::steady_clock;
+    size_t reps = 1;
+    double best = 1e300;
+    for (int round = 0; round < 3; round++) {
+        double elapsed;
+        for (;;) {
+            auto start = clock::now();
+            for (size_t i = 0; i < reps; i++)
+                Multiply::multiply(a.data(), n, b.data(), n, c.data());
+            elapsed = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+            if (elapsed >= 20000)
+                break;
+            reps *= 2;
+        }
+        best = std::min(best, elapsed / reps);
+    }
+    return best;
+}
+
+// 在 n 位时分别让 threshold 取 n + 1（低一层）和 n（高一层），比较顶层用哪一层更快
+// 递归下去的子问题都小于 n，仍按低一层处理
+struct Row {
+    size_t n;
+    double lower, upper;
+};
+std::vector<Row> sweep(size_t &threshold, size_t from, size_t to) {
+    std::vector<Row> rows;
+    for (size_t n = from; n <= to; n += std::max<size_t>(1, n / 8)) {
+        threshold = n + 1;
+        double lower = measure(n);
+        threshold = n;
+        double upper = measure(n);
+        rows.push_back({n, lower, upper});
+    }
+    return rows;
+}
+
+// 交叉点：从这一行起高一层连续两个采样点都更快
+size_t crossover(const std::vector<Row> &rows) {
+    for (size_t i = 0; i + 1 < rows.size(); i++)
+        if (rows[i].upper < rows[i].lower && rows[i + 1].upper < rows[i + 1].lower)
+            return rows[i].n;
+    return rows.back().n;
+}
+
+void report(const char *lower, const char *upper, const std::vector<Row> &rows, size_t x) {
+    std::printf("\n%-8s %12s %12s %8s\n", "limbs", lower, upper, "ratio");
+    for (auto &r : rows)
+        std::printf("%-8zu %12.2f %12.2f %8.2f%s\n", r.n, r.lower, r.upper, r.lower / r.upper,
+                    r.n == x ? "  <- crossover" : "");
+}
+
+const char *isa_name(NTT::Isa isa) {
+    switch (isa) {
+    case NTT::Isa::avx512:
+        return "avx512";
+    case NTT::Isa::avx2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::string path = argc > 1 ? argv[1] : "MultiplyConfig.h";
+    const size_t INF = size_t(-1);
+    const char *isa = isa_name(NTT::cpu_isa());
+    std::printf("isa: %s, threads: %u (times in microseconds per multiply)\n", isa,
+                std::thread::hardware_concurrency());
+
+    // 逐层确定：先定 Karatsuba，再在其上定 Toom-3，最后定 NTT
+    Multiply::TOOM3_THRESHOLD = Multiply::NTT_THRESHOLD = INF;
+    auto karatsuba = sweep(Multiply::KARATSUBA_THRESHOLD, 8, 160);
+    size_t k = crossover(karatsuba);
+    report("schoolbook", "karatsuba", karatsuba, k);
+    Multiply::KARATSUBA_THRESHOLD = k;
+
+    auto toom3 = sweep(Multiply::TOOM3_THRESHOLD, std::max<size_t>(k * 2, 48), 2000);
+    size_t t = crossover(toom3);
+    report("karatsuba", "toom3", toom3, t);
+    Multiply::TOOM3_THRESHOLD = t;
+
+    auto ntt = sweep(Multiply::NTT_THRESHOLD, 32, 4000);
+    size_t n = crossover(ntt);
+    report("tiers", "ntt", ntt, n);
+
+    std::printf("\nKARATSUBA_THRESHOLD %zu\nTOOM3_THRESHOLD %zu\nNTT_THRESHOLD %zu\n", k, t, n);
+    std::ofstream out(path);
+    out << "#pragma once\n"
+        << "// 由 Tune.cpp 生成（isa: " << isa << "），Multiply.h 编译时读取\n"
+        << "#define MULTIPLY_KARATSUBA_THRESHOLD " << k << "\n"
+        << "#define MULTIPLY_TOOM3_THRESHOLD " << t << "\n"
+        << "#define MULTIPLY_NTT_THRESHOLD " << n << "\n";
+    std::cout << "written to " << path << std::endl;
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/bin/sh
+# 依次编译并运行每个头文件的 Benchmark.cpp，把结果合并输出
+# 用法：./bench.sh [csv|json|text] [传给 bench 的参数，如 --max 100000 --time 0.5]
+# 环境变量 CXX、CXXFLAGS 可以替换编译器与编译选项
+set -e
+format=${1:-csv}
+[ $# -gt 0 ] && shift
+cd "$(dirname "$0")"
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+first=1
+[ "$format" = json ] && echo "["
+for variant in BigInt.h:big_int BigIntStatic.h:big_int BigUInt.h:big_uint BigUIntStatic.h:big_uint \
+    BigUIntStd.h:big_uint BigUIntBinary.h:big_uint; do
+    header=${variant%%:*}
+    type=${variant##*:}
+    ${CXX:-g++} -std=c++17 ${CXXFLAGS:--O2} -pthread -DBENCH_HEADER="\"$header\"" \
+        -DBENCH_TYPE="$type" -o "$dir/bench" Benchmark.cpp
+    case $format in
+    csv) "$dir/bench" --format csv "$@" | { [ $first = 1 ] && cat || tail -n +2; } ;;
+    json) [ $first = 1 ] || echo ","; "$dir/bench" --format json "$@" ;;
+    *) "$dir/bench" --format text "$@" | { [ $first = 1 ] && cat || tail -n +2; } ;;
+    esac
+    first=0
+done
+[ "$format" = json ] && echo "]"
+exit 0
@@ -1,5 +1,9 @@
 #include <vector>
 #include <random>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <utility>
 
 template <typename BigInt> void check(long long a, long long b) {
     BigInt x(a), y(b), c;
@@ -29,6 +33,52 @@ template <typename BigInt> void check(long long a, long long b) {
     c *= y;
     if (c != BigInt(a * b))
         std::cout << "ERROR *= : " << a << " " << b << " " << c << ' ' << std::endl;
+#ifndef BIGINT_STATIC_LIMBS // 定长版本没有除法和 int64_t 运算
+    if (b != 0) {
+        if ((x / y) != BigInt(a / b))
+            std::cout << "ERROR / : " << a << " " << b << " " << x / y << ' ' << BigInt(a / b) << std::endl;
+        if ((x % y) != BigInt(a % b))
+            std::cout << "ERROR % : " << a << " " << b << " " << x % y << ' ' << BigInt(a % b) << std::endl;
+        auto [q, r] = divmod(x, y);
+        if (q != BigInt(a / b) || r != BigInt(a % b))
+            std::cout << "ERROR divmod : " << a << " " << b << " " << q << ' ' << r << std::endl;
+        c = x;
+        c /= y;
+        if (c != BigInt(a / b))
+            std::cout << "ERROR /= : " << a << " " << b << " " << c << ' ' << std::endl;
+        c = x;
+        c %= y;
+        if (c != BigInt(a % b))
+            std::cout << "ERROR %= : " << a << " " << b << " " << c << ' ' << std::endl;
+    }
+    // 与 int64_t 的运算
+    int64_t s = b;
+    if (x + s != BigInt(a + b) || s + x != BigInt(a + b))
+        std::cout << "ERROR + int64 : " << a << " " << b << std::endl;
+    if (x - s != BigInt(a - b))
+        std::cout << "ERROR - int64 : " << a << " " << b << std::endl;
+    if (x * s != BigInt(a * b) || s * x != BigInt(a * b))
+        std::cout << "ERROR * int64 : " << a << " " << b << std::endl;
+    c = x, c += s;
+    if (c != BigInt(a + b))
+        std::cout << "ERROR += int64 : " << a << " " << b << std::endl;
+    c = x, c -= s;
+    if (c != BigInt(a - b))
+        std::cout << "ERROR -= int64 : " << a << " " << b << std::endl;
+    c = x, c *= s;
+    if (c != BigInt(a * b))
+        std::cout << "ERROR *= int64 : " << a << " " << b << std::endl;
+    if (s != 0) {
+        if (x / s != BigInt(a / b) || x % s != BigInt(a % b))
+            std::cout << "ERROR / % int64 : " << a << " " << b << std::endl;
+        c = x, c /= s;
+        if (c != BigInt(a / b))
+            std::cout << "ERROR /= int64 : " << a << " " << b << std::endl;
+        c = x, c %= s;
+        if (c != BigInt(a % b))
+            std::cout << "ERROR %= int64 : " << a << " " << b << std::endl;
+    }
+#endif
 }
 template<typename BigInt>
 void test() {
@@ -61,4 +111,113 @@ void randtest() {
         check<BigInt>(a[i], b[i]);
 
     }
-}
\ No newline at end of file
+}
+#ifndef BIGINT_STATIC_LIMBS
+// n 位的随机十进制数，最高位非零
+std::string randdigits(std::mt19937 &rng, size_t n) {
+    std::string s(n, '0');
+    for (char &c : s)
+        c = '0' + rng() % 10;
+    s[0] = '1' + rng() % 9;
+    return s;
+}
+// 构造 a = q * b + r 检查商和余数
+template <typename BigInt> void checkdiv(const BigInt &q, const BigInt &b, const BigInt &r, const char *name) {
+    auto [q2, r2] = divmod(q * b + r, b);
+    if (q2 != q || r2 != r)
+        std::cout << "ERROR divmod " << name << std::endl;
+}
+// 除数和商都超过 NEWTON_THRESHOLD 时走牛顿迭代求倒数与分块试商，另外把阈值调低覆盖递归的各层
+template <typename BigInt> void divtest() {
+    std::mt19937 rng(2024);
+    size_t old = Divide::NEWTON_THRESHOLD;
+    for (size_t threshold : {old, size_t(2), size_t(8)}) {
+        Divide::NEWTON_THRESHOLD = threshold;
+        size_t n = threshold == old ? 4000 : 600; // 十进制位数，阈值为默认值时除数超过 200 位（2^32 进制下也是）
+        BigInt a(randdigits(rng, n * 2)), b(randdigits(rng, n)), q(randdigits(rng, n));
+        auto [q1, r1] = divmod(a, b);
+        if (q1 * b + r1 != a || !(r1 < b))
+            std::cout << "ERROR newton divmod " << threshold << std::endl;
+        checkdiv(q, b, BigInt(0), "exact");
+        checkdiv(q, b, b - BigInt(1), "r = b - 1");
+        // 全为 9 的除数，试商最容易偏大
+        BigInt nines(std::string(n, '9'));
+        checkdiv(q, nines, nines - BigInt(1), "all 9s");
+        checkdiv(nines, nines, BigInt(0), "all 9s square");
+    }
+    Divide::NEWTON_THRESHOLD = old;
+}
+#endif
+// 边界情况：解析错误、std::string；动态版本另外检查与整数直接比较、小对象优化下的拷贝和移动、大数除法
+template <typename BigInt> void edgetest() {
+    BigInt x(42);
+    const char bad[] = "abc", mixed[] = "123abc";
+    auto [p1, e1] = from_chars(bad, bad + 3, x);
+    if (e1 != std::errc::invalid_argument || p1 != bad || x != BigInt(42))
+        std::cout << "ERROR from_chars abc" << std::endl;
+    auto [p2, e2] = from_chars(bad, bad, x);
+    if (e2 != std::errc::invalid_argument || p2 != bad || x != BigInt(42))
+        std::cout << "ERROR from_chars empty" << std::endl;
+    auto [p3, e3] = from_chars(mixed, mixed + 6, x);
+    if (e3 != std::errc() || p3 != mixed + 3 || x != BigInt(123))
+        std::cout << "ERROR from_chars 123abc" << std::endl;
+
+    std::string str = "1" + std::string(40, '0');
+    BigInt big(str), small(1234);
+    if (big.to_string() != str || BigInt(std::string("1234")) != small)
+        std::cout << "ERROR std::string ctor" << std::endl;
+    x = std::string("5");
+    if (x != BigInt(5))
+        std::cout << "ERROR std::string assign" << std::endl;
+
+#ifndef BIGINT_STATIC_LIMBS
+    if (!(x == 5) || !(5 == x) || !(3 < x) || !(x <= 5))
+        std::cout << "ERROR compare with int" << std::endl;
+
+    // 短数存放在对象内，长数在堆上，两种情况分别检查拷贝、移动和互相赋值
+    BigInt s1(small), s2(std::move(s1)), b1(big), b2(std::move(b1));
+    if (s2 != small || b2 != big)
+        std::cout << "ERROR copy / move" << std::endl;
+    s1 = big, b1 = small;
+    if (s1 != big || b1 != small)
+        std::cout << "ERROR reuse after move" << std::endl;
+    s2 = std::move(b2), b2 = std::move(s1);
+    if (s2 != big || b2 != big)
+        std::cout << "ERROR move assign" << std::endl;
+    s2 = small;
+    if (s2 != small || s2.to_string() != "1234")
+        std::cout << "ERROR shrink" << std::endl;
+
+    // 多位除数，a == q * b + r 且 r < b
+    BigInt a(std::string(300, '7')), b(std::string(120, '3') + "1");
+    auto [q, r] = divmod(a, b);
+    if (q * b + r != a || !(r < b) || a / b != q || a % b != r)
+        std::cout << "ERROR long divmod" << std::endl;
+    if (divmod(b, a).first != BigInt(0) || divmod(b, a).second != b)
+        std::cout << "ERROR divmod small by large" << std::endl;
+    divtest<BigInt>();
+#endif
+}
+#ifdef BIGINT_STATIC_LIMBS
+// 定长版本：超出位数、前导零、最高位为零的乘积
+template <typename BigInt> void statictest() {
+    size_t digits = BIGINT_STATIC_LIMBS * 4;
+    std::string full(digits, '9'), over = "1" + std::string(digits, '0'), padded = std::string(10, '0') + full;
+    BigInt x(7);
+    auto [p1, e1] = from_chars(over.data(), over.data() + over.size(), x);
+    if (e1 != std::errc::result_out_of_range || p1 != over.data() + over.size() || x != BigInt(7))
+        std::cout << "ERROR from_chars out of range" << std::endl;
+    auto [p2, e2] = from_chars(padded.data(), padded.data() + padded.size(), x);
+    if (e2 != std::errc() || x.to_string() != full)
+        std::cout << "ERROR from_chars leading zeros" << std::endl;
+    if ((x * BigInt(1)).to_string() != full || (BigInt(1) * x).to_string() != full)
+        std::cout << "ERROR full width product" << std::endl;
+    auto y = 12345_big;
+    if (y != BigInt(12345) || 0_big != BigInt(0))
+        std::cout << "ERROR _big literal" << std::endl;
+#if __cplusplus >= 202002L
+    static_assert(12345_big == BigInt(12345));
+    static_assert(99999999_big * 2_big == BigInt(199999998));
+#endif
+}
+#endif